@@ -0,0 +1,158 @@
+// Общие функции для бенчмарков на Google Benchmark.
+//
+// Все входные данные генерируются детерминированно (фиксированный seed и
+// portable_random.h вместо распределений стандартной библиотеки), чтобы
+// результаты разных запусков и разных сборок можно было сравнивать. Размеры
+// задач перебираются степенями десяти от 10^3 до BENCHMARK_MAX_SCALE
+// (переменная окружения, по умолчанию 10^6, максимум 10^8).
+//
+// Каждый бенчмарк сообщает:
+// items_per_second - пропускную способность (операций в секунду);
+// time_per_op - время одной операции;
+// peak_rss_mb - пиковое потребление памяти процессом на момент замера.
+
+
+#ifndef COMMON_BENCHMARK_UTILS_H
+#define COMMON_BENCHMARK_UTILS_H
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <sys/resource.h>
+
+#include "portable_random.h"
+
+
+// Seed генераторов входных данных по умолчанию
+const uint64_t benchmark_seed = 20200214;
+// Минимальный и максимальный размеры задач
+const int64_t benchmark_min_scale = 1000;
+const int64_t benchmark_max_scale = 100000000;
+
+
+// Максимальный размер задачи из переменной окружения BENCHMARK_MAX_SCALE
+inline int64_t GetMaxScale() {
+    const char *value = std::getenv("BENCHMARK_MAX_SCALE");
+    int64_t max_scale = value ? std::atoll(value) : 1000000;
+
+    if (max_scale < benchmark_min_scale) {
+        max_scale = benchmark_min_scale;
+    }
+    if (max_scale > benchmark_max_scale) {
+        max_scale = benchmark_max_scale;
+    }
+
+    return max_scale;
+}
+
+
+// Аргументы 10^3, 10^4, ..., не больше limit и GetMaxScale()
+inline void ScaleArgumentsUpTo(benchmark::internal::Benchmark *b,
+                               int64_t limit) {
+    for (int64_t n = benchmark_min_scale;
+         (n <= limit) && (n <= GetMaxScale()); n *= 10) {
+        b->Arg(n);
+    }
+}
+
+
+// Аргументы 10^3, 10^4, ..., GetMaxScale()
+inline void ScaleArguments(benchmark::internal::Benchmark *b) {
+    ScaleArgumentsUpTo(b, benchmark_max_scale);
+}
+
+
+// Аргументы для квадратичных (вырожденных) случаев: 10^3, 10^4
+inline void QuadraticScaleArguments(benchmark::internal::Benchmark *b) {
+    ScaleArgumentsUpTo(b, 10000);
+}
+
+
+// Количество потоков для многопоточных бенчмарков: 1, 2, 4, ..., число ядер
+inline void ThreadArguments(benchmark::internal::Benchmark *b) {
+    const int max_threads = std::max(
+            1, static_cast<int>(std::thread::hardware_concurrency()));
+    b->ThreadRange(1, max_threads);
+}
+
+
+// Время работы: O(1)
+inline double GetPeakRSSMegabytes() {
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+    // На macOS ru_maxrss измеряется в байтах
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    // На Linux ru_maxrss измеряется в килобайтах
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+
+// Записать счетчики для бенчмарка, выполняющего n_ops операций за итерацию
+inline void ReportCounters(benchmark::State &state, int64_t n_ops) {
+    state.SetItemsProcessed(state.iterations() * n_ops);
+    state.counters["time_per_op"] = benchmark::Counter(
+            static_cast<double>(n_ops),
+            benchmark::Counter::kIsIterationInvariantRate |
+            benchmark::Counter::kInvert);
+    state.counters["peak_rss_mb"] = GetPeakRSSMegabytes();
+}
+
+
+// Время работы: O(n)
+inline std::vector<int> GenerateRandomInts(size_t n, int min_value,
+                                           int max_value,
+                                           uint64_t seed = benchmark_seed) {
+    std::mt19937_64 generator(seed);
+
+    std::vector<int> values(n);
+    for (int &value : values) {
+        value = static_cast<int>(RandomInRange(generator, min_value,
+                                               max_value));
+    }
+
+    return values;
+}
+
+
+// Время работы: O(n)
+inline std::vector<int> GenerateSortedInts(size_t n, bool is_descending) {
+    std::vector<int> values(n);
+    for (size_t i = 0; i < n; i++) {
+        values[i] = static_cast<int>(is_descending ? n - i : i);
+    }
+
+    return values;
+}
+
+
+// Время работы: O(n * max_length)
+inline std::vector<std::string> GenerateRandomStrings(
+        size_t n, size_t min_length, size_t max_length, char max_letter = 'z',
+        uint64_t seed = benchmark_seed) {
+    std::mt19937_64 generator(seed);
+
+    std::vector<std::string> strings(n);
+    for (std::string &str : strings) {
+        str.resize(static_cast<size_t>(RandomInRange(generator, min_length,
+                                                     max_length)));
+        for (char &ch : str) {
+            ch = static_cast<char>(RandomInRange(generator, 'a', max_letter));
+        }
+    }
+
+    return strings;
+}
+
+
+#endif //COMMON_BENCHMARK_UTILS_H
@@ -0,0 +1,104 @@
+// Конвейер проверки команд очереди (дека): разбор и выполнение в разных
+// потоках.
+//
+// Поток разбора читает текстовые команды и складывает их пакетами по
+// batch_size записей QueueCommand в один из нескольких буферов, а текущий
+// поток выполняет готовые пакеты. Буферы передаются между потоками по номерам
+// через две SpscQueue (заполненные и свободные), поэтому разбор следующего
+// пакета идет одновременно с выполнением предыдущего, а выполнение проходит
+// по плотному массиву команд без разбора текста.
+//
+// Если пакет не прошел проверку, конвейер останавливается: поток разбора
+// завершается, не дочитывая входные данные.
+
+
+#ifndef COMMON_COMMAND_PIPELINE_H
+#define COMMON_COMMAND_PIPELINE_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "command_trace.h"
+#include "concurrent_queue.h"
+#include "fast_input.h"
+
+
+// Количество буферов пакетов
+const int pipeline_buffer_count = 4;
+
+
+// Прочитать n команд из input и выполнить их пакетами: execute(commands,
+// count) выполняет count команд и возвращает false, если проверка не прошла.
+// Возвращает false, если какой-либо пакет не прошел проверку
+// Время работы: O(n) + время выполнения команд
+template<typename TExecute>
+bool RunCommandPipeline(FastInput &input, int n, TExecute execute,
+                        size_t batch_size = 4096) {
+    std::vector<std::vector<QueueCommand>> buffers(
+            pipeline_buffer_count, std::vector<QueueCommand>(batch_size));
+    std::vector<size_t> counts(pipeline_buffer_count, 0);
+    // Номера заполненных буферов (-1 - команды закончились) и свободных
+    SpscQueue<int> full_buffers(2 * pipeline_buffer_count);
+    SpscQueue<int> free_buffers(pipeline_buffer_count);
+    for (int i = 0; i < pipeline_buffer_count; i++) {
+        free_buffers.Push(i);
+    }
+    std::atomic<bool> is_stopped(false);
+
+    std::thread parser([&]() {
+        int remaining = n;
+        while (remaining > 0) {
+            // Ждем свободный буфер, пока выполнение не остановлено
+            int index = -1;
+            while (!free_buffers.TryPop(index)) {
+                if (is_stopped.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+
+            std::vector<QueueCommand> &buffer = buffers[index];
+            size_t count = 0;
+            bool is_read = true;
+            while ((count < batch_size) && (remaining > 0) && is_read) {
+                QueueCommand &command = buffer[count];
+                is_read = input.ReadInt(command.command) &&
+                          input.ReadInt(command.value);
+                count += is_read;
+                remaining--;
+            }
+
+            counts[index] = count;
+            full_buffers.Push(index);
+            if (!is_read) {
+                // Входные данные закончились раньше n команд
+                break;
+            }
+        }
+        full_buffers.Push(-1);
+    });
+
+    bool is_correct = true;
+    while (is_correct) {
+        const int index = full_buffers.Pop();
+        if (index == -1) {
+            break;
+        }
+
+        is_correct = execute(buffers[index].data(), counts[index]);
+        if (is_correct) {
+            free_buffers.Push(index);
+        }
+    }
+    // После ошибки поток разбора завершится, не дожидаясь свободного буфера
+    is_stopped.store(true, std::memory_order_relaxed);
+
+    parser.join();
+    return is_correct;
+}
+
+
+#endif //COMMON_COMMAND_PIPELINE_H
@@ -0,0 +1,182 @@
+// Двоичная трасса команд очереди (дека).
+//
+// Текстовые входные данные задач 1_3 и Lesson_1 - это n пар чисел "команда
+// значение". Трасса хранит те же команды готовыми записями QueueCommand, и
+// при воспроизведении записанной трассы ничего не разбирается: файл
+// отображается в память, и команды выполняются прямо из отображения.
+//
+// Формат файла (порядок байтов - как у процессора, на котором трасса
+// записана): Header, затем count записей QueueCommand.
+
+
+#ifndef COMMON_COMMAND_TRACE_H
+#define COMMON_COMMAND_TRACE_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "fast_output.h"
+
+
+// Команда очереди: command - номер команды (1-4), value - добавляемое или
+// ожидаемое значение
+struct QueueCommand {
+    int32_t command;
+    int32_t value;
+};
+
+
+class CommandTrace {
+private:
+    // Заголовок файла
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        // Количество команд
+        uint64_t count;
+    };
+
+    static const uint32_t version = 1;
+
+    // Отображенный в память файл
+    void *data;
+    size_t data_size;
+    const QueueCommand *commands;
+    size_t count;
+
+    static const char *GetMagic();
+
+public:
+    // Открыть трассу из файлового дескриптора fd (дескриптор не закрывается),
+    // при ошибке бросается runtime_error
+    explicit CommandTrace(int fd);
+
+    // Констурктор копирования
+    CommandTrace(const CommandTrace &) = delete;
+
+    // Конструктор перемещения
+    CommandTrace(CommandTrace &&) = delete;
+
+    // Оператор присваивания копированием
+    CommandTrace &operator=(const CommandTrace &) = delete;
+
+    // Оператор присваивания перемещением
+    CommandTrace &operator=(CommandTrace &&) = delete;
+
+    ~CommandTrace();
+
+    // Является ли fd обычным файлом, начинающимся с заголовка трассы (из
+    // pipe трассу прочитать нельзя: его начало нельзя прочитать повторно)
+    static bool IsTrace(int fd);
+
+    // Записать трассу из команд commands в output
+    static void Write(const std::vector<QueueCommand> &commands_,
+                      FastOutput &output);
+
+    const QueueCommand *Commands() const;
+
+    size_t Size() const;
+};
+
+
+// Время работы: O(1)
+inline const char *CommandTrace::GetMagic() {
+    // 8 символов без завершающего нуля
+    return "QCMDTRC1";
+}
+
+
+// Время работы: O(1) (страницы файла читаются при первом обращении)
+inline CommandTrace::CommandTrace(int fd) : data(nullptr), data_size(0),
+                                            commands(nullptr), count(0) {
+    struct stat file_stat;
+    if ((fstat(fd, &file_stat) != 0) ||
+        (static_cast<size_t>(file_stat.st_size) < sizeof(Header))) {
+        throw std::runtime_error("invalid command trace");
+    }
+    data_size = static_cast<size_t>(file_stat.st_size);
+
+    data = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        data = nullptr;
+        throw std::runtime_error("cannot map command trace");
+    }
+    madvise(data, data_size, MADV_SEQUENTIAL);
+
+    const Header *header = static_cast<const Header *>(data);
+    if ((std::memcmp(header->magic, GetMagic(), sizeof(header->magic)) != 0) ||
+        (header->version != version) ||
+        (header->count != (data_size - sizeof(Header)) /
+                          sizeof(QueueCommand)) ||
+        ((data_size - sizeof(Header)) % sizeof(QueueCommand) != 0)) {
+        munmap(data, data_size);
+        data = nullptr;
+        throw std::runtime_error("invalid command trace");
+    }
+
+    // Размер заголовка кратен 8, поэтому команды выровнены
+    commands = reinterpret_cast<const QueueCommand *>(header + 1);
+    count = static_cast<size_t>(header->count);
+}
+
+
+// Время работы: O(1)
+inline CommandTrace::~CommandTrace() {
+    if (data) {
+        munmap(data, data_size);
+    }
+}
+
+
+// Время работы: O(1)
+inline bool CommandTrace::IsTrace(int fd) {
+    struct stat file_stat;
+    if ((fstat(fd, &file_stat) != 0) || !S_ISREG(file_stat.st_mode)) {
+        return false;
+    }
+
+    // pread не сдвигает позицию чтения дескриптора
+    char magic[8];
+    return (pread(fd, magic, sizeof(magic), 0) ==
+            static_cast<ssize_t>(sizeof(magic))) &&
+           (std::memcmp(magic, GetMagic(), sizeof(magic)) == 0);
+}
+
+
+// Время работы: O(commands_.size())
+inline void CommandTrace::Write(const std::vector<QueueCommand> &commands_,
+                                FastOutput &output) {
+    Header header;
+    std::memcpy(header.magic, GetMagic(), sizeof(header.magic));
+    header.version = version;
+    header.reserved = 0;
+    header.count = commands_.size();
+
+    output.Write(reinterpret_cast<const char *>(&header), sizeof(header));
+    output.Write(reinterpret_cast<const char *>(commands_.data()),
+                 commands_.size() * sizeof(QueueCommand));
+}
+
+
+// Время работы: O(1)
+inline const QueueCommand *CommandTrace::Commands() const {
+    return commands;
+}
+
+
+// Время работы: O(1)
+inline size_t CommandTrace::Size() const {
+    return count;
+}
+
+
+#endif //COMMON_COMMAND_TRACE_H
@@ -0,0 +1,354 @@
+// Ограниченные неблокирующие очереди для передачи данных между потоками.
+//
+// SpscQueue - кольцевой буфер для одного производителя и одного потребителя:
+// каждый индекс изменяет только один поток, поэтому хватает атомарных чтений и
+// записей без CAS. Каждая сторона хранит последний прочитанный индекс другой
+// стороны и перечитывает его, только когда буфер кажется полным (пустым).
+//
+// MpmcQueue - очередь Вьюкова для нескольких производителей и потребителей:
+// у каждой ячейки есть номер последовательности, по которому поток узнает,
+// можно ли писать в ячейку (читать из нее), а позицию в очереди поток
+// занимает одним CAS.
+//
+// Индексы производителей и потребителей лежат в разных кэш-линиях, чтобы
+// запись одного индекса не сбрасывала кэш-линию другого у соседнего ядра.
+//
+// TryPush и TryPop не ждут и возвращают false, если очередь полна (пуста).
+// Push и Pop ждут места (элемента), уступая процессор другим потокам.
+// Empty во время работы других потоков может устареть сразу после возврата.
+
+
+#ifndef COMMON_CONCURRENT_QUEUE_H
+#define COMMON_CONCURRENT_QUEUE_H
+
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+
+// Размер кэш-линии
+const size_t cache_line_size = 64;
+
+
+// Индекс одной стороны очереди в отдельной кэш-линии. Объект в куче выровнен
+// только на 16 байт (C++14 не выравнивает new по alignas), поэтому индекс
+// отделен от соседних полей запасом в две кэш-линии
+struct PaddedIndex {
+    // Индекс, который изменяет эта сторона
+    std::atomic<size_t> value;
+    // Последний прочитанный индекс другой стороны (только SpscQueue)
+    size_t cached;
+    char padding[2 * cache_line_size - sizeof(std::atomic<size_t>) -
+                 sizeof(size_t)];
+
+    PaddedIndex();
+};
+
+
+template<typename T>
+class SpscQueue {
+private:
+    // Размер буфера - степень двойки, mask = размер - 1
+    const size_t mask;
+    std::unique_ptr<T[]> buffer;
+    char padding[cache_line_size];
+    // Позиция первого элемента (изменяет потребитель)
+    PaddedIndex head;
+    // Позиция после последнего элемента (изменяет производитель)
+    PaddedIndex tail;
+
+public:
+    // Очередь не меньше чем на capacity элементов
+    explicit SpscQueue(size_t capacity);
+
+    // Констурктор копирования
+    SpscQueue(const SpscQueue &) = delete;
+
+    // Конструктор перемещения
+    SpscQueue(SpscQueue &&) = delete;
+
+    // Оператор присваивания копированием
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Оператор присваивания перемещением
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    bool Empty() const;
+
+    size_t Capacity() const;
+
+    // Добавить элемент, false - очередь полна (только производитель)
+    bool TryPush(const T &value);
+
+    // Извлечь элемент в value, false - очередь пуста (только потребитель)
+    bool TryPop(T &value);
+
+    // Добавить элемент, дождавшись места
+    void Push(const T &value);
+
+    // Извлечь элемент, дождавшись его
+    T Pop();
+};
+
+
+template<typename T>
+class MpmcQueue {
+private:
+    // Ячейка очереди: sequence = позиция - ячейка свободна для записи в
+    // позицию, sequence = позиция + 1 - в ячейке элемент позиции
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    // Размер буфера - степень двойки, mask = размер - 1
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    char padding[cache_line_size];
+    // Следующая позиция для записи
+    PaddedIndex enqueue_pos;
+    // Следующая позиция для чтения
+    PaddedIndex dequeue_pos;
+
+public:
+    // Очередь не меньше чем на capacity элементов
+    explicit MpmcQueue(size_t capacity);
+
+    // Констурктор копирования
+    MpmcQueue(const MpmcQueue &) = delete;
+
+    // Конструктор перемещения
+    MpmcQueue(MpmcQueue &&) = delete;
+
+    // Оператор присваивания копированием
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+    // Оператор присваивания перемещением
+    MpmcQueue &operator=(MpmcQueue &&) = delete;
+
+    bool Empty() const;
+
+    size_t Capacity() const;
+
+    // Добавить элемент, false - очередь полна
+    bool TryPush(const T &value);
+
+    // Извлечь элемент в value, false - очередь пуста
+    bool TryPop(T &value);
+
+    // Добавить элемент, дождавшись места
+    void Push(const T &value);
+
+    // Извлечь элемент, дождавшись его
+    T Pop();
+};
+
+
+// Наименьшая степень двойки, не меньшая capacity (не меньше 2)
+// Время работы: O(log(capacity))
+inline size_t GetQueueBufferSize(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    return size;
+}
+
+
+inline PaddedIndex::PaddedIndex() : value(0), cached(0) {}
+
+
+template<typename T>
+SpscQueue<T>::SpscQueue(size_t capacity)
+        : mask(GetQueueBufferSize(capacity) - 1), buffer(new T[mask + 1]) {}
+
+
+// Время работы: O(1)
+template<typename T>
+bool SpscQueue<T>::Empty() const {
+    return head.value.load(std::memory_order_acquire) ==
+           tail.value.load(std::memory_order_acquire);
+}
+
+
+// Время работы: O(1)
+template<typename T>
+size_t SpscQueue<T>::Capacity() const {
+    return mask + 1;
+}
+
+
+// Время работы: O(1)
+template<typename T>
+bool SpscQueue<T>::TryPush(const T &value) {
+    const size_t pos = tail.value.load(std::memory_order_relaxed);
+    if (pos - tail.cached > mask) {
+        // Буфер кажется полным: перечитываем позицию потребителя
+        tail.cached = head.value.load(std::memory_order_acquire);
+        if (pos - tail.cached > mask) {
+            return false;
+        }
+    }
+
+    buffer[pos & mask] = value;
+    // release: потребитель увидит элемент вместе с новой позицией
+    tail.value.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+
+// Время работы: O(1)
+template<typename T>
+bool SpscQueue<T>::TryPop(T &value) {
+    const size_t pos = head.value.load(std::memory_order_relaxed);
+    if (pos == head.cached) {
+        // Буфер кажется пустым: перечитываем позицию производителя
+        head.cached = tail.value.load(std::memory_order_acquire);
+        if (pos == head.cached) {
+            return false;
+        }
+    }
+
+    value = std::move(buffer[pos & mask]);
+    // release: производитель перезапишет ячейку только после чтения
+    head.value.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+
+// Время работы: O(1) + ожидание места
+template<typename T>
+void SpscQueue<T>::Push(const T &value) {
+    while (!TryPush(value)) {
+        std::this_thread::yield();
+    }
+}
+
+
+// Время работы: O(1) + ожидание элемента
+template<typename T>
+T SpscQueue<T>::Pop() {
+    T value;
+    while (!TryPop(value)) {
+        std::this_thread::yield();
+    }
+
+    return value;
+}
+
+
+template<typename T>
+MpmcQueue<T>::MpmcQueue(size_t capacity)
+        : mask(GetQueueBufferSize(capacity) - 1), cells(new Cell[mask + 1]) {
+    for (size_t i = 0; i <= mask; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+// Время работы: O(1)
+template<typename T>
+bool MpmcQueue<T>::Empty() const {
+    return dequeue_pos.value.load(std::memory_order_acquire) >=
+           enqueue_pos.value.load(std::memory_order_acquire);
+}
+
+
+// Время работы: O(1)
+template<typename T>
+size_t MpmcQueue<T>::Capacity() const {
+    return mask + 1;
+}
+
+
+// Время работы: O(1) без конкуренции, иначе до числа потоков повторов CAS
+template<typename T>
+bool MpmcQueue<T>::TryPush(const T &value) {
+    size_t pos = enqueue_pos.value.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true) {
+        cell = &cells[pos & mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            // Ячейка свободна: занимаем позицию, если ее не занял другой поток
+            if (enqueue_pos.value.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // В ячейке еще лежит элемент позиции pos - размер буфера
+            return false;
+        } else {
+            // Позицию уже занял другой производитель
+            pos = enqueue_pos.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+
+// Время работы: O(1) без конкуренции, иначе до числа потоков повторов CAS
+template<typename T>
+bool MpmcQueue<T>::TryPop(T &value) {
+    size_t pos = dequeue_pos.value.load(std::memory_order_relaxed);
+    Cell *cell = nullptr;
+    while (true) {
+        cell = &cells[pos & mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(sequence) -
+                              static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            // В ячейке элемент: занимаем позицию, если ее не занял другой поток
+            if (dequeue_pos.value.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Элемент позиции pos еще не записан
+            return false;
+        } else {
+            // Позицию уже занял другой потребитель
+            pos = dequeue_pos.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    value = std::move(cell->value);
+    // Ячейка свободна для записи в позицию pos + размер буфера
+    cell->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+}
+
+
+// Время работы: O(1) + ожидание места
+template<typename T>
+void MpmcQueue<T>::Push(const T &value) {
+    while (!TryPush(value)) {
+        std::this_thread::yield();
+    }
+}
+
+
+// Время работы: O(1) + ожидание элемента
+template<typename T>
+T MpmcQueue<T>::Pop() {
+    T value;
+    while (!TryPop(value)) {
+        std::this_thread::yield();
+    }
+
+    return value;
+}
+
+
+#endif //COMMON_CONCURRENT_QUEUE_H
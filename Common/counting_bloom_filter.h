@@ -0,0 +1,179 @@
+// Блочный фильтр Блума со счетчиками (с поддержкой удаления).
+//
+// Фильтр отвечает на вопрос "может ли ключ быть во множестве": ответ "нет"
+// всегда верен, ответ "может быть" иногда ошибочен (ложноположительный). Вместо
+// битов используются 4-битные счетчики, поэтому ключи можно удалять.
+//
+// Все hash_count счетчиков ключа лежат в одном блоке размером с кэш-линию
+// (128 счетчиков в 64 байтах), номер блока и номера счетчиков берутся из
+// разных битов хэша. Поэтому проверка ключа читает одну кэш-линию. Счетчик,
+// достигший максимума, больше не изменяется, чтобы удаление не могло
+// привести к ложноотрицательному ответу.
+//
+// Фильтр работает с готовыми 64-битными хэшами ключей.
+
+
+#ifndef COMMON_COUNTING_BLOOM_FILTER_H
+#define COMMON_COUNTING_BLOOM_FILTER_H
+
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+class CountingBloomFilter {
+private:
+    // 64-битных слов в блоке (блок - одна кэш-линия)
+    static const size_t block_words = 8;
+    // Счетчиков в слове и бит в счетчике
+    static const size_t counters_per_word = 16;
+    static const int counter_bits = 4;
+    static const uint64_t max_counter = 15;
+    // Количество счетчиков ключа и бит хэша на номер счетчика в блоке
+    static const int hash_count = 4;
+    static const int index_bits = 7;
+    // Ключей на блок: 16 счетчиков на ключ (около 0.5% ложноположительных
+    // ответов при заполнении до capacity)
+    static const size_t keys_per_block = 8;
+
+    // Память выделяется с запасом, чтобы выровнять блоки по кэш-линиям
+    std::unique_ptr<uint64_t[]> storage;
+    uint64_t *blocks;
+    // Количество блоков - степень двойки
+    size_t block_count;
+    int block_bits;
+
+    // Первое слово блока ключа с хэшем hash
+    uint64_t *GetBlock(size_t hash) const;
+
+    // Номер i-го счетчика ключа с хэшем hash в блоке
+    static size_t GetCounter(size_t hash, int i);
+
+public:
+    // Фильтр на capacity ключей
+    explicit CountingBloomFilter(size_t capacity);
+
+    // Констурктор копирования
+    CountingBloomFilter(const CountingBloomFilter &) = delete;
+
+    // Конструктор перемещения
+    CountingBloomFilter(CountingBloomFilter &&) = default;
+
+    // Оператор присваивания копированием
+    CountingBloomFilter &operator=(const CountingBloomFilter &) = delete;
+
+    // Оператор присваивания перемещением
+    CountingBloomFilter &operator=(CountingBloomFilter &&) = default;
+
+    void Add(size_t hash);
+
+    // Удалить ключ, который был добавлен (иначе возможны ложноотрицательные
+    // ответы)
+    void Remove(size_t hash);
+
+    // false - ключа точно нет, true - ключ, возможно, есть
+    bool MayContain(size_t hash) const;
+
+    // Предвыборка в кэш блока ключа с хэшем hash
+    void Prefetch(size_t hash) const;
+
+    // Количество ключей, на которое рассчитан фильтр
+    size_t Capacity() const;
+};
+
+
+inline CountingBloomFilter::CountingBloomFilter(size_t capacity)
+        : blocks(nullptr), block_count(1), block_bits(0) {
+    while (block_count * keys_per_block < capacity) {
+        block_count *= 2;
+        block_bits++;
+    }
+
+    const size_t words = block_count * block_words;
+    storage.reset(new uint64_t[words + block_words]());
+    const uintptr_t address = reinterpret_cast<uintptr_t>(storage.get());
+    const uintptr_t line = block_words * sizeof(uint64_t);
+    blocks = reinterpret_cast<uint64_t *>((address + line - 1) / line * line);
+}
+
+
+// Время работы: O(1)
+inline uint64_t *CountingBloomFilter::GetBlock(size_t hash) const {
+    // Номер блока - старшие биты перемешанного хэша, они не пересекаются с
+    // младшими битами, из которых берутся номера счетчиков
+    const uint64_t mixed = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    const size_t block = (block_bits == 0) ? 0 : mixed >> (64 - block_bits);
+
+    return blocks + block * block_words;
+}
+
+
+// Время работы: O(1)
+inline size_t CountingBloomFilter::GetCounter(size_t hash, int i) {
+    return (hash >> (i * index_bits)) & ((1u << index_bits) - 1);
+}
+
+
+// Время работы: O(hash_count)
+inline void CountingBloomFilter::Add(size_t hash) {
+    uint64_t *block = GetBlock(hash);
+    for (int i = 0; i < hash_count; i++) {
+        const size_t counter = GetCounter(hash, i);
+        uint64_t &word = block[counter / counters_per_word];
+        const int shift = (counter % counters_per_word) * counter_bits;
+        if (((word >> shift) & max_counter) != max_counter) {
+            word += uint64_t(1) << shift;
+        }
+    }
+}
+
+
+// Время работы: O(hash_count)
+inline void CountingBloomFilter::Remove(size_t hash) {
+    uint64_t *block = GetBlock(hash);
+    for (int i = 0; i < hash_count; i++) {
+        const size_t counter = GetCounter(hash, i);
+        uint64_t &word = block[counter / counters_per_word];
+        const int shift = (counter % counters_per_word) * counter_bits;
+        const uint64_t value = (word >> shift) & max_counter;
+        assert(value > 0);
+
+        // Насыщенный счетчик мог быть увеличен больше раз, чем учтено
+        if ((value != max_counter) && (value != 0)) {
+            word -= uint64_t(1) << shift;
+        }
+    }
+}
+
+
+// Время работы: O(hash_count)
+inline bool CountingBloomFilter::MayContain(size_t hash) const {
+    const uint64_t *block = GetBlock(hash);
+    for (int i = 0; i < hash_count; i++) {
+        const size_t counter = GetCounter(hash, i);
+        const uint64_t word = block[counter / counters_per_word];
+        const int shift = (counter % counters_per_word) * counter_bits;
+        if (((word >> shift) & max_counter) == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// Время работы: O(1)
+inline void CountingBloomFilter::Prefetch(size_t hash) const {
+    __builtin_prefetch(GetBlock(hash));
+}
+
+
+// Время работы: O(1)
+inline size_t CountingBloomFilter::Capacity() const {
+    return block_count * keys_per_block;
+}
+
+
+#endif //COMMON_COUNTING_BLOOM_FILTER_H
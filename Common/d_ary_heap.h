@@ -0,0 +1,90 @@
+// Просеивание в d-арной куче, общее для MinHeap из Hometask_2_3 и
+// IndexedMinHeap.
+//
+// Куча хранится в массиве: у элемента с номером pos дети имеют номера
+// arity * pos + 1, ..., arity * pos + arity. Функции работают только с
+// номерами элементов, а сравнение и перестановку элементов выполняют
+// переданные функторы: is_less(first, second) - элемент first меньше элемента
+// second, swap(first, second) - поменять элементы местами. Поэтому одна и та
+// же реализация подходит и для кучи значений, и для кучи номеров с
+// позициями.
+
+
+#ifndef COMMON_D_ARY_HEAP_H
+#define COMMON_D_ARY_HEAP_H
+
+
+#include <algorithm>
+
+
+// Номер родителя элемента pos (для корня - 0)
+// Время работы: O(1)
+template<int arity>
+inline int DAryParent(int pos) {
+    return (pos - 1) / arity;
+}
+
+
+// Номер первого ребенка элемента pos
+// Время работы: O(1)
+template<int arity>
+inline int DAryFirstChild(int pos) {
+    return arity * pos + 1;
+}
+
+
+// Наименьший из детей элемента pos в куче из size элементов (-1, если детей
+// нет)
+// Время работы: O(arity)
+template<int arity, typename TIsLess>
+int FindMinChild(int pos, int size, TIsLess is_less) {
+    const int first_child = DAryFirstChild<arity>(pos);
+    if (first_child >= size) {
+        return -1;
+    }
+    const int last_child = std::min(first_child + arity, size) - 1;
+
+    int min_child = first_child;
+    for (int child = first_child + 1; child <= last_child; child++) {
+        if (is_less(child, min_child)) {
+            min_child = child;
+        }
+    }
+
+    return min_child;
+}
+
+
+// Просеять элемент pos вверх
+// Время работы: O(log(n) / log(arity))
+template<int arity, typename TIsLess, typename TSwap>
+void DArySiftUp(int pos, TIsLess is_less, TSwap swap) {
+    // int((0 - 1) / arity) = 0, а элемент не меньше самого себя, поэтому цикл
+    // гарантировано остановится при pos = 0 (возможно остановится раньше)
+    while (is_less(pos, DAryParent<arity>(pos))) {
+        swap(pos, DAryParent<arity>(pos));
+        pos = DAryParent<arity>(pos);
+    }
+}
+
+
+// Просеять элемент pos вниз в куче из size элементов
+// Время работы: O(arity * log(n) / log(arity))
+template<int arity, typename TIsLess, typename TSwap>
+void DArySiftDown(int pos, int size, TIsLess is_less, TSwap swap) {
+    while (true) {
+        const int min_child = FindMinChild<arity>(pos, size, is_less);
+
+        // Если детей нет или родитель не больше, чем наименьший из детей, то
+        // свойство мин. кучи восстановлено, и просеивание закончено
+        if ((min_child == -1) || !is_less(min_child, pos)) {
+            break;
+        }
+
+        swap(pos, min_child);
+        pos = min_child;
+    }
+}
+
+
+#endif //COMMON_D_ARY_HEAP_H
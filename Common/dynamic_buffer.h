@@ -0,0 +1,288 @@
+// Динамический буфер с настраиваемой политикой изменения размера.
+//
+// CapacityPolicy задает, во сколько раз буфер расширяется при заполнении,
+// при какой доле занятых ячеек и до какого размера он сужается, и сужается ли
+// вообще. После сужения буфер занят на shrink_threshold / shrink_factor, т.е.
+// между порогами сужения и расширения остается запас (гистерезис), и
+// колебания размера около одной границы не вызывают перевыделение на каждом
+// шаге.
+//
+// DynamicBuffer<T> хранит только память: количество элементов знает владелец
+// (стек, куча) и передает его в методы. Буфер тривиальных типов выделяется
+// через malloc и изменяется через realloc (часто без копирования), для
+// остальных типов элементы переносятся в новый буфер, выделенный через new[].
+
+
+#ifndef COMMON_DYNAMIC_BUFFER_H
+#define COMMON_DYNAMIC_BUFFER_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+// Политика изменения размера буфера
+struct CapacityPolicy {
+    // Во сколько раз буфер расширяется при заполнении
+    double growth_factor = 2;
+    // Буфер сужается, когда занято не больше shrink_threshold его ячеек,
+    double shrink_threshold = 0.125;
+    // до shrink_factor от текущего размера
+    double shrink_factor = 0.5;
+    // false - буфер никогда не сужается
+    bool is_shrinking = true;
+    // Размер, меньше которого буфер не сужается
+    size_t min_capacity = 20;
+
+    // Размер буфера после расширения заполненного буфера размера capacity
+    size_t GetGrownCapacity(size_t capacity) const;
+
+    // Размер буфера размера capacity с size элементами после сужения
+    // (capacity - если сужать не нужно)
+    size_t GetShrunkCapacity(size_t capacity, size_t size) const;
+};
+
+
+template<typename T>
+class DynamicBuffer {
+private:
+    // realloc допустим только для тривиальных типов
+    typedef std::is_trivial<T> is_reallocatable;
+
+    T *data;
+    size_t capacity;
+    const CapacityPolicy policy;
+    // Размер, заказанный через Reserve: меньше него буфер не сужается
+    size_t reserved;
+    // Буфер получен от владельца и выделен через new[]
+    bool is_adopted;
+
+    // Изменить размер буфера с size элементами на new_capacity
+    void Reallocate(size_t new_capacity, size_t size);
+
+    void Reallocate(size_t new_capacity, size_t size, std::true_type);
+
+    void Reallocate(size_t new_capacity, size_t size, std::false_type);
+
+    // Освободить память буфера
+    void Release();
+
+public:
+    explicit DynamicBuffer(const CapacityPolicy &policy_ = CapacityPolicy());
+
+    // Стать владельцем буфера data_ размера capacity_, выделенного через new[]
+    DynamicBuffer(T *data_, size_t capacity_,
+                  const CapacityPolicy &policy_ = CapacityPolicy());
+
+    ~DynamicBuffer();
+
+    // Констурктор копирования
+    DynamicBuffer(const DynamicBuffer &) = delete;
+
+    // Конструктор перемещения
+    DynamicBuffer(DynamicBuffer &&) = delete;
+
+    // Оператор присваивания копированием
+    DynamicBuffer &operator=(const DynamicBuffer &) = delete;
+
+    // Оператор присваивания перемещением
+    DynamicBuffer &operator=(DynamicBuffer &&) = delete;
+
+    T &operator[](size_t i);
+
+    const T &operator[](size_t i) const;
+
+    size_t Capacity() const;
+
+    // Расширить буфер с size элементами, если в нем нет места для еще одного
+    void PrepareForPush(size_t size);
+
+    // Сузить буфер с size элементами, если этого требует политика
+    void ShrinkIfNeeded(size_t size);
+
+    // Расширить буфер с size элементами до new_capacity; меньше new_capacity
+    // буфер больше не сужается
+    void Reserve(size_t new_capacity, size_t size);
+};
+
+
+// Время работы: O(1)
+inline size_t CapacityPolicy::GetGrownCapacity(size_t capacity) const {
+    const size_t grown = static_cast<size_t>(capacity * growth_factor);
+
+    return std::max(std::max(grown, capacity + 1), min_capacity);
+}
+
+
+// Время работы: O(1)
+inline size_t CapacityPolicy::GetShrunkCapacity(size_t capacity,
+                                                size_t size) const {
+    if (!is_shrinking || (size > capacity * shrink_threshold)) {
+        return capacity;
+    }
+
+    const size_t shrunk = static_cast<size_t>(capacity * shrink_factor);
+    return std::max(std::max(shrunk, size), std::min(min_capacity, capacity));
+}
+
+
+template<typename T>
+DynamicBuffer<T>::DynamicBuffer(const CapacityPolicy &policy_)
+        : data(nullptr), capacity(0), policy(policy_), reserved(0),
+          is_adopted(false) {
+    // После сужения в буфере должно оставаться свободное место, иначе
+    // следующее добавление сразу расширит его обратно
+    assert(policy.growth_factor > 1);
+    assert(policy.shrink_threshold < policy.shrink_factor);
+
+    Reallocate(policy.min_capacity, 0);
+}
+
+
+template<typename T>
+DynamicBuffer<T>::DynamicBuffer(T *data_, size_t capacity_,
+                                const CapacityPolicy &policy_)
+        : data(data_), capacity(capacity_), policy(policy_), reserved(0),
+          is_adopted(true) {
+    assert(policy.growth_factor > 1);
+    assert(policy.shrink_threshold < policy.shrink_factor);
+}
+
+
+template<typename T>
+DynamicBuffer<T>::~DynamicBuffer() {
+    Release();
+}
+
+
+template<typename T>
+void DynamicBuffer<T>::Release() {
+    if (is_adopted || !is_reallocatable::value) {
+        delete[] data;
+    } else {
+        std::free(data);
+    }
+}
+
+
+// Время работы: O(size)
+template<typename T>
+void DynamicBuffer<T>::Reallocate(size_t new_capacity, size_t size) {
+    assert(size <= new_capacity);
+
+    // Буфер, выделенный через new[], нельзя передавать в realloc
+    if (is_adopted) {
+        Reallocate(new_capacity, size, std::false_type());
+        is_adopted = !is_reallocatable::value;
+        return;
+    }
+    Reallocate(new_capacity, size, is_reallocatable());
+}
+
+
+// Время работы: O(size) (realloc часто расширяет буфер на месте)
+template<typename T>
+void DynamicBuffer<T>::Reallocate(size_t new_capacity, size_t,
+                                  std::true_type) {
+    // realloc размера 0 может вернуть nullptr без ошибки
+    void *new_data = std::realloc(data, std::max<size_t>(new_capacity, 1) *
+                                        sizeof(T));
+    if (!new_data) {
+        throw std::bad_alloc();
+    }
+
+    data = static_cast<T *>(new_data);
+    capacity = new_capacity;
+}
+
+
+// Время работы: O(size)
+template<typename T>
+void DynamicBuffer<T>::Reallocate(size_t new_capacity, size_t size,
+                                  std::false_type) {
+    T *new_data = nullptr;
+    if (is_adopted && is_reallocatable::value) {
+        // Переходим на malloc, чтобы следующие изменения использовали realloc
+        new_data = static_cast<T *>(
+                std::malloc(std::max<size_t>(new_capacity, 1) * sizeof(T)));
+        if (!new_data) {
+            throw std::bad_alloc();
+        }
+    } else {
+        new_data = new T[new_capacity];
+    }
+
+    // Переносим элементы из старого буфера в новый
+    for (size_t i = 0; i < size; i++) {
+        new_data[i] = std::move(data[i]);
+    }
+
+    delete[] data;
+    data = new_data;
+    capacity = new_capacity;
+}
+
+
+// Время работы: O(1)
+template<typename T>
+T &DynamicBuffer<T>::operator[](size_t i) {
+    assert(i < capacity);
+
+    return data[i];
+}
+
+
+// Время работы: O(1)
+template<typename T>
+const T &DynamicBuffer<T>::operator[](size_t i) const {
+    assert(i < capacity);
+
+    return data[i];
+}
+
+
+// Время работы: O(1)
+template<typename T>
+size_t DynamicBuffer<T>::Capacity() const {
+    return capacity;
+}
+
+
+// Амортизированное время работы: O(1)
+template<typename T>
+void DynamicBuffer<T>::PrepareForPush(size_t size) {
+    assert(size <= capacity);
+
+    if (size == capacity) {
+        Reallocate(policy.GetGrownCapacity(capacity), size);
+    }
+}
+
+
+// Амортизированное время работы: O(1)
+template<typename T>
+void DynamicBuffer<T>::ShrinkIfNeeded(size_t size) {
+    const size_t new_capacity = std::max(
+            policy.GetShrunkCapacity(capacity, size), reserved);
+    if (new_capacity < capacity) {
+        Reallocate(new_capacity, size);
+    }
+}
+
+
+// Время работы: O(size) (O(1), если буфер уже не меньше new_capacity)
+template<typename T>
+void DynamicBuffer<T>::Reserve(size_t new_capacity, size_t size) {
+    reserved = new_capacity;
+    if (new_capacity > capacity) {
+        Reallocate(new_capacity, size);
+    }
+}
+
+
+#endif //COMMON_DYNAMIC_BUFFER_H
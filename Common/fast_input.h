@@ -0,0 +1,368 @@
+// Быстрое чтение входных данных.
+//
+// FastInput читает файловый дескриптор (по умолчанию stdin) большими блоками
+// через read(2), а если дескриптор указывает на обычный файл - отображает его
+// в память целиком через mmap. Числа и токены разбираются вручную, без
+// iostream и без локалей, поэтому время чтения 10^6 чисел пренебрежимо мало по
+// сравнению со временем работы самих алгоритмов.
+//
+// Методы Read* пропускают пробельные символы и возвращают false, если входные
+// данные закончились или очередной токен не является значением нужного типа
+// (аналогично состоянию fail у std::cin).
+
+
+#ifndef COMMON_FAST_INPUT_H
+#define COMMON_FAST_INPUT_H
+
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+class FastInput {
+private:
+    // Размер буфера для чтения через read(2)
+    static const size_t buffer_size = 1 << 16;
+
+    int fd;
+    // Буфер для чтения через read(2) (nullptr, если используется mmap)
+    char *buffer;
+    // Отображение файла в память (nullptr, если используется read(2))
+    char *mapped;
+    size_t mapped_size;
+    // Текущая позиция и конец доступных данных
+    const char *pos;
+    const char *end;
+
+    // Прочитать следующий блок в буфер, false - если данные закончились
+    bool Refill();
+
+    // Текущий символ или -1, если данные закончились
+    int Peek();
+
+    // Пропустить пробельные символы, false - если данные закончились
+    bool SkipSpaces();
+
+    // Прочитать целое число со знаком в диапазоне типа T (false, если число
+    // не помещается в T)
+    template<typename T>
+    bool ReadSigned(T &value);
+
+public:
+    explicit FastInput(int fd_ = STDIN_FILENO);
+
+    ~FastInput();
+
+    // Констурктор копирования
+    FastInput(const FastInput &) = delete;
+
+    // Конструктор перемещения
+    FastInput(FastInput &&) = delete;
+
+    // Оператор присваивания копированием
+    FastInput &operator=(const FastInput &) = delete;
+
+    // Оператор присваивания перемещением
+    FastInput &operator=(FastInput &&) = delete;
+
+    bool ReadInt(int &value);
+
+    bool ReadInt64(int64_t &value);
+
+    bool ReadDouble(double &value);
+
+    // Прочитать последовательность непробельных символов
+    bool ReadToken(std::string &token);
+
+    // Прочитать один непробельный символ
+    bool ReadChar(char &ch);
+};
+
+
+inline FastInput::FastInput(int fd_) : fd(fd_), buffer(nullptr),
+                                       mapped(nullptr), mapped_size(0),
+                                       pos(nullptr), end(nullptr) {
+    // Обычный файл отображается в память целиком, остальные источники (pipe,
+    // терминал) читаются блоками
+    struct stat st = {};
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+        void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+            mapped = static_cast<char *>(addr);
+            mapped_size = st.st_size;
+
+            // Учитываем уже прочитанную часть файла (если она есть)
+            off_t offset = lseek(fd, 0, SEEK_CUR);
+            if ((offset < 0) || (offset > st.st_size)) {
+                offset = 0;
+            }
+            pos = mapped + offset;
+            end = mapped + mapped_size;
+            return;
+        }
+    }
+
+    buffer = new char[buffer_size];
+    pos = end = buffer;
+}
+
+
+inline FastInput::~FastInput() {
+    if (mapped) {
+        munmap(mapped, mapped_size);
+    }
+    delete[] buffer;
+}
+
+
+// Время работы: O(buffer_size)
+inline bool FastInput::Refill() {
+    if (!buffer) {
+        // Отображенный файл уже прочитан целиком
+        return false;
+    }
+
+    ssize_t n_read = 0;
+    do {
+        n_read = read(fd, buffer, buffer_size);
+    } while ((n_read < 0) && (errno == EINTR));
+
+    if (n_read <= 0) {
+        pos = end = buffer;
+        return false;
+    }
+
+    pos = buffer;
+    end = buffer + n_read;
+    return true;
+}
+
+
+// Амортизированное время работы: O(1)
+inline int FastInput::Peek() {
+    if ((pos == end) && !Refill()) {
+        return -1;
+    }
+
+    return static_cast<unsigned char>(*pos);
+}
+
+
+// Время работы: O(количество пропущенных символов)
+inline bool FastInput::SkipSpaces() {
+    while (true) {
+        int ch = Peek();
+        if (ch == -1) {
+            return false;
+        }
+        if ((ch != ' ') && (ch != '\n') && (ch != '\r') && (ch != '\t') &&
+            (ch != '\v') && (ch != '\f')) {
+            return true;
+        }
+        pos++;
+    }
+}
+
+
+// Время работы: O(длина числа)
+template<typename T>
+bool FastInput::ReadSigned(T &value) {
+    if (!SkipSpaces()) {
+        return false;
+    }
+
+    bool is_negative = false;
+    if ((*pos == '-') || (*pos == '+')) {
+        is_negative = (*pos == '-');
+        pos++;
+    }
+
+    int ch = Peek();
+    if ((ch < '0') || (ch > '9')) {
+        return false;
+    }
+
+    // Число накапливается в беззнаковом типе, чтобы корректно прочитать
+    // минимальное значение типа T, модуль которого на единицу больше
+    // максимального
+    const uint64_t limit =
+            static_cast<uint64_t>(std::numeric_limits<T>::max()) + is_negative;
+    uint64_t result = 0;
+    bool is_overflow = false;
+    while ((ch >= '0') && (ch <= '9')) {
+        const uint64_t digit = static_cast<uint64_t>(ch - '0');
+        // Переполненное число дочитывается до конца, как у std::cin
+        if (result > (limit - digit) / 10) {
+            is_overflow = true;
+        } else {
+            result = result * 10 + digit;
+        }
+        pos++;
+        ch = Peek();
+    }
+
+    if (is_overflow) {
+        return false;
+    }
+
+    value = static_cast<T>(is_negative ? 0 - result : result);
+    return true;
+}
+
+
+inline bool FastInput::ReadInt(int &value) {
+    return ReadSigned(value);
+}
+
+
+inline bool FastInput::ReadInt64(int64_t &value) {
+    return ReadSigned(value);
+}
+
+
+// Время работы: O(длина числа)
+inline bool FastInput::ReadDouble(double &value) {
+    // Точные степени десяти, представимые в double
+    static const double powers_of_ten[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const int max_exact_power = 22;
+    // Показатель степени, после которого результат - бесконечность или ноль
+    const int max_exponent = 100000;
+    // Количество значащих цифр, помещающихся в uint64_t без переполнения
+    const int max_digits = 19;
+
+    if (!SkipSpaces()) {
+        return false;
+    }
+
+    bool is_negative = false;
+    if ((*pos == '-') || (*pos == '+')) {
+        is_negative = (*pos == '-');
+        pos++;
+    }
+
+    // Число представляется как mantissa * 10^exponent
+    uint64_t mantissa = 0;
+    int n_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+
+    int ch = Peek();
+    // Целая часть
+    for (; (ch >= '0') && (ch <= '9'); pos++, ch = Peek()) {
+        has_digits = true;
+        if (n_digits < max_digits) {
+            mantissa = mantissa * 10 + (ch - '0');
+            n_digits += (mantissa != 0);
+        } else {
+            exponent++;
+        }
+    }
+
+    // Дробная часть
+    if (ch == '.') {
+        pos++;
+        for (ch = Peek(); (ch >= '0') && (ch <= '9'); pos++, ch = Peek()) {
+            has_digits = true;
+            if (n_digits < max_digits) {
+                mantissa = mantissa * 10 + (ch - '0');
+                n_digits += (mantissa != 0);
+                exponent--;
+            }
+        }
+    }
+
+    if (!has_digits) {
+        return false;
+    }
+
+    // Показатель степени: знак и цифры идут сразу после 'e', без пробелов
+    if ((ch == 'e') || (ch == 'E')) {
+        pos++;
+        ch = Peek();
+        bool is_exp_negative = false;
+        if ((ch == '-') || (ch == '+')) {
+            is_exp_negative = (ch == '-');
+            pos++;
+            ch = Peek();
+        }
+        if ((ch < '0') || (ch > '9')) {
+            return false;
+        }
+
+        int exp_value = 0;
+        for (; (ch >= '0') && (ch <= '9'); pos++, ch = Peek()) {
+            if (exp_value < max_exponent) {
+                exp_value = exp_value * 10 + (ch - '0');
+            }
+        }
+        exponent += is_exp_negative ? -exp_value : exp_value;
+    }
+
+    double result = static_cast<double>(mantissa);
+    if ((exponent >= 0) && (exponent <= max_exact_power)) {
+        result *= powers_of_ten[exponent];
+    } else if ((exponent < 0) && (exponent >= -max_exact_power)) {
+        // Деление на точную степень дает меньшую погрешность, чем умножение
+        // на неточное 10^(-k)
+        result /= powers_of_ten[-exponent];
+    } else {
+        result *= std::pow(10.0, exponent);
+    }
+
+    value = is_negative ? -result : result;
+    return true;
+}
+
+
+// Время работы: O(token.size())
+inline bool FastInput::ReadToken(std::string &token) {
+    token.clear();
+    if (!SkipSpaces()) {
+        return false;
+    }
+
+    while (true) {
+        // Копируем непробельные символы текущего блока целиком
+        const char *token_end = pos;
+        while ((token_end != end) && (*token_end != ' ') &&
+               (*token_end != '\n') && (*token_end != '\r') &&
+               (*token_end != '\t') && (*token_end != '\v') &&
+               (*token_end != '\f')) {
+            token_end++;
+        }
+        token.append(pos, token_end);
+        pos = token_end;
+
+        // Токен закончился внутри блока или данные закончились
+        if ((pos != end) || !Refill()) {
+            return true;
+        }
+    }
+}
+
+
+// Амортизированное время работы: O(1)
+inline bool FastInput::ReadChar(char &ch) {
+    if (!SkipSpaces()) {
+        return false;
+    }
+
+    ch = *pos++;
+    return true;
+}
+
+
+#endif //COMMON_FAST_INPUT_H
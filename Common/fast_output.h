@@ -0,0 +1,159 @@
+// Быстрый вывод.
+//
+// FastOutput накапливает вывод в буфере и записывает его в файловый
+// дескриптор (по умолчанию stdout) через write(2) одним вызовом: когда буфер
+// заполнен, при явном вызове Flush и в деструкторе. В отличие от
+// std::cout << std::endl, строки не сбрасываются по одной, поэтому вывод 10^6
+// строк занимает несколько системных вызовов.
+
+
+#ifndef COMMON_FAST_OUTPUT_H
+#define COMMON_FAST_OUTPUT_H
+
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <unistd.h>
+
+
+class FastOutput {
+private:
+    // Размер буфера
+    static const size_t buffer_size = 1 << 16;
+
+    int fd;
+    char *buffer;
+    // Количество байтов в буфере
+    size_t size;
+
+    // Записать length байтов в дескриптор, false - при ошибке записи
+    bool WriteAll(const char *data, size_t length);
+
+public:
+    explicit FastOutput(int fd_ = STDOUT_FILENO);
+
+    ~FastOutput();
+
+    // Констурктор копирования
+    FastOutput(const FastOutput &) = delete;
+
+    // Конструктор перемещения
+    FastOutput(FastOutput &&) = delete;
+
+    // Оператор присваивания копированием
+    FastOutput &operator=(const FastOutput &) = delete;
+
+    // Оператор присваивания перемещением
+    FastOutput &operator=(FastOutput &&) = delete;
+
+    void Write(const char *data, size_t length);
+
+    void WriteString(const std::string &str);
+
+    void WriteChar(char ch);
+
+    void WriteInt64(int64_t value);
+
+    // Записать содержимое буфера, false - при ошибке записи
+    bool Flush();
+};
+
+
+inline FastOutput::FastOutput(int fd_) : fd(fd_),
+                                         buffer(new char[buffer_size]),
+                                         size(0) {}
+
+
+inline FastOutput::~FastOutput() {
+    Flush();
+    delete[] buffer;
+}
+
+
+// Время работы: O(length)
+inline bool FastOutput::WriteAll(const char *data, size_t length) {
+    while (length > 0) {
+        const ssize_t n_written = write(fd, data, length);
+        if (n_written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        data += n_written;
+        length -= n_written;
+    }
+
+    return true;
+}
+
+
+// Амортизированное время работы: O(length)
+inline void FastOutput::Write(const char *data, size_t length) {
+    if (size + length > buffer_size) {
+        Flush();
+    }
+
+    // Длинные данные записываются сразу, минуя буфер
+    if (length > buffer_size) {
+        WriteAll(data, length);
+        return;
+    }
+
+    std::memcpy(buffer + size, data, length);
+    size += length;
+}
+
+
+// Амортизированное время работы: O(str.size())
+inline void FastOutput::WriteString(const std::string &str) {
+    Write(str.data(), str.size());
+}
+
+
+// Амортизированное время работы: O(1)
+inline void FastOutput::WriteChar(char ch) {
+    if (size == buffer_size) {
+        Flush();
+    }
+
+    buffer[size++] = ch;
+}
+
+
+// Время работы: O(длина числа)
+inline void FastOutput::WriteInt64(int64_t value) {
+    // Цифры записываются с конца; модуль вычисляется в беззнаковом типе,
+    // чтобы корректно вывести минимальное значение int64_t
+    char digits[20];
+    size_t n_digits = 0;
+    uint64_t abs_value = (value < 0) ? 0 - static_cast<uint64_t>(value)
+                                     : static_cast<uint64_t>(value);
+    do {
+        digits[sizeof(digits) - 1 - n_digits++] =
+                static_cast<char>('0' + abs_value % 10);
+        abs_value /= 10;
+    } while (abs_value != 0);
+
+    if (value < 0) {
+        WriteChar('-');
+    }
+    Write(digits + sizeof(digits) - n_digits, n_digits);
+}
+
+
+// Время работы: O(buffer_size)
+inline bool FastOutput::Flush() {
+    const bool is_written = WriteAll(buffer, size);
+    size = 0;
+
+    return is_written;
+}
+
+
+#endif //COMMON_FAST_OUTPUT_H
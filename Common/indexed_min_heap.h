@@ -0,0 +1,218 @@
+// Минимальная d-арная куча с индексами (для алгоритмов Прима и Дейкстры).
+//
+// Элементы - номера 0..max_size - 1, у каждого свой ключ. Куча хранит номера
+// элементов, а для каждого номера - его позицию в куче, поэтому ключ
+// элемента, уже лежащего в куче, можно уменьшить за O(log(n)) (DecreaseKey)
+// вместо удаления и повторной вставки. Просеивание общее с MinHeap из
+// Hometask_2_3 (d_ary_heap.h), но вместе с элементами переставляются их
+// позиции.
+//
+// Вся память выделяется в конструкторе, Push, Pop и DecreaseKey память не
+// выделяют.
+
+
+#ifndef COMMON_INDEXED_MIN_HEAP_H
+#define COMMON_INDEXED_MIN_HEAP_H
+
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "d_ary_heap.h"
+
+
+template<typename TKey, typename TCompare = std::less<TKey>, int arity = 2>
+class IndexedMinHeap {
+private:
+    static_assert(arity >= 2, "IndexedMinHeap arity must be at least 2");
+
+    // Номера элементов в порядке кучи
+    std::vector<int> heap;
+    // Позиция элемента в heap (-1, если элемента нет в куче)
+    std::vector<int> positions;
+    // Ключ элемента
+    std::vector<TKey> keys;
+    TCompare compare; // Сравнение ключей: compare(a, b) - a меньше b
+
+    // Элемент в позиции first меньше элемента в позиции second
+    bool IsLess(int first, int second) const;
+
+    // Поменять местами элементы в позициях first и second
+    void Swap(int first, int second);
+
+    // Просеять элемент вверх
+    void SiftUp(int pos);
+
+    // Просеять элемент вниз
+    void SiftDown(int pos);
+
+public:
+    explicit IndexedMinHeap(int max_size,
+                            const TCompare &compare_ = TCompare());
+
+    // Констурктор копирования
+    IndexedMinHeap(const IndexedMinHeap &) = delete;
+
+    // Конструктор перемещения
+    IndexedMinHeap(IndexedMinHeap &&) = delete;
+
+    // Оператор присваивания копированием
+    IndexedMinHeap &operator=(const IndexedMinHeap &) = delete;
+
+    // Оператор присваивания перемещением
+    IndexedMinHeap &operator=(IndexedMinHeap &&) = delete;
+
+    bool Empty() const;
+
+    int Size() const;
+
+    // Лежит ли элемент id в куче
+    bool Contains(int id) const;
+
+    // Номер элемента с минимальным ключом
+    int Top() const;
+
+    // Ключ элемента id, лежащего в куче
+    const TKey &GetKey(int id) const;
+
+    // Добавить элемент id с ключом key
+    void Push(int id, const TKey &key);
+
+    // Извлечь элемент с минимальным ключом, вернуть его номер
+    int Pop();
+
+    // Уменьшить ключ элемента id, лежащего в куче, до key
+    void DecreaseKey(int id, const TKey &key);
+};
+
+
+template<typename TKey, typename TCompare, int arity>
+IndexedMinHeap<TKey, TCompare, arity>::IndexedMinHeap(int max_size,
+                                                      const TCompare &compare_)
+        : positions(max_size, -1), keys(max_size), compare(compare_) {
+    assert(max_size >= 0);
+
+    heap.reserve(max_size);
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+bool IndexedMinHeap<TKey, TCompare, arity>::IsLess(int first,
+                                                    int second) const {
+    return compare(keys[heap[first]], keys[heap[second]]);
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+void IndexedMinHeap<TKey, TCompare, arity>::Swap(int first, int second) {
+    std::swap(heap[first], heap[second]);
+    positions[heap[first]] = first;
+    positions[heap[second]] = second;
+}
+
+
+// Время работы: O(log(n) / log(arity))
+template<typename TKey, typename TCompare, int arity>
+void IndexedMinHeap<TKey, TCompare, arity>::SiftUp(int pos) {
+    DArySiftUp<arity>(pos, [this](int first, int second) {
+        return IsLess(first, second);
+    }, [this](int first, int second) {
+        Swap(first, second);
+    });
+}
+
+
+// Время работы: O(arity * log(n) / log(arity))
+template<typename TKey, typename TCompare, int arity>
+void IndexedMinHeap<TKey, TCompare, arity>::SiftDown(int pos) {
+    DArySiftDown<arity>(pos, Size(), [this](int first, int second) {
+        return IsLess(first, second);
+    }, [this](int first, int second) {
+        Swap(first, second);
+    });
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+bool IndexedMinHeap<TKey, TCompare, arity>::Empty() const {
+    return heap.empty();
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+int IndexedMinHeap<TKey, TCompare, arity>::Size() const {
+    return static_cast<int>(heap.size());
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+bool IndexedMinHeap<TKey, TCompare, arity>::Contains(int id) const {
+    return positions[id] != -1;
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+int IndexedMinHeap<TKey, TCompare, arity>::Top() const {
+    assert(!Empty());
+
+    return heap[0];
+}
+
+
+// Время работы: O(1)
+template<typename TKey, typename TCompare, int arity>
+const TKey &IndexedMinHeap<TKey, TCompare, arity>::GetKey(int id) const {
+    assert(Contains(id));
+
+    return keys[id];
+}
+
+
+// Время работы: O(log(n) / log(arity))
+template<typename TKey, typename TCompare, int arity>
+void IndexedMinHeap<TKey, TCompare, arity>::Push(int id, const TKey &key) {
+    assert(!Contains(id));
+
+    keys[id] = key;
+    positions[id] = Size();
+    heap.push_back(id);
+    SiftUp(positions[id]);
+}
+
+
+// Время работы: O(arity * log(n) / log(arity))
+template<typename TKey, typename TCompare, int arity>
+int IndexedMinHeap<TKey, TCompare, arity>::Pop() {
+    const int result = Top();
+
+    Swap(0, Size() - 1);
+    heap.pop_back();
+    positions[result] = -1;
+    if (!Empty()) {
+        SiftDown(0);
+    }
+
+    return result;
+}
+
+
+// Время работы: O(log(n) / log(arity))
+template<typename TKey, typename TCompare, int arity>
+void IndexedMinHeap<TKey, TCompare, arity>::DecreaseKey(int id,
+                                                        const TKey &key) {
+    assert(Contains(id) && !compare(keys[id], key));
+
+    keys[id] = key;
+    SiftUp(positions[id]);
+}
+
+
+#endif //COMMON_INDEXED_MIN_HEAP_H
@@ -0,0 +1,125 @@
+// Пул узлов для связных структур данных (списков, деревьев, цепочек
+// хэш-таблиц).
+//
+// Узлы выделяются блоками по block_size штук, а освобожденные узлы попадают в
+// список свободных и переиспользуются. Поэтому New и Delete не обращаются к
+// системному аллокатору, узлы лежат в памяти плотно, а вся память пула
+// освобождается сразу в деструкторе. Деструкторы еще не удаленных узлов при
+// этом не вызываются, поэтому тип узла должен быть тривиально разрушаемым.
+
+
+#ifndef COMMON_NODE_POOL_H
+#define COMMON_NODE_POOL_H
+
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+template<typename T>
+class NodePool {
+private:
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "NodePool does not call destructors of remaining nodes");
+
+    // Свободная ячейка хранит указатель на следующую свободную ячейку
+    union Slot {
+        Slot *next;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    // Количество ячеек в блоке
+    const size_t block_size;
+    // Количество использованных ячеек последнего блока
+    size_t block_used;
+    // Список свободных ячеек
+    Slot *free_list;
+    // Количество живых узлов
+    size_t size;
+
+public:
+    explicit NodePool(size_t block_size_ = 1024);
+
+    // Констурктор копирования
+    NodePool(const NodePool &) = delete;
+
+    // Конструктор перемещения
+    NodePool(NodePool &&) = delete;
+
+    // Оператор присваивания копированием
+    NodePool &operator=(const NodePool &) = delete;
+
+    // Оператор присваивания перемещением
+    NodePool &operator=(NodePool &&) = delete;
+
+    // Создать узел с аргументами конструктора args
+    template<typename... Args>
+    T *New(Args &&... args);
+
+    // Удалить узел, созданный этим пулом
+    void Delete(T *node);
+
+    // Количество живых узлов
+    size_t Size() const;
+};
+
+
+template<typename T>
+NodePool<T>::NodePool(size_t block_size_) : block_size(block_size_),
+                                            block_used(block_size_),
+                                            free_list(nullptr), size(0) {
+    assert(block_size > 0);
+}
+
+
+// Амортизированное время работы: O(1)
+template<typename T>
+template<typename... Args>
+T *NodePool<T>::New(Args &&... args) {
+    Slot *slot = nullptr;
+    if (free_list) {
+        slot = free_list;
+        free_list = free_list->next;
+    } else {
+        if (block_used == block_size) {
+            blocks.emplace_back(new Slot[block_size]);
+            block_used = 0;
+        }
+        slot = &blocks.back()[block_used++];
+    }
+
+    size++;
+    return new(&slot->storage) T(std::forward<Args>(args)...);
+}
+
+
+// Время работы: O(1)
+template<typename T>
+void NodePool<T>::Delete(T *node) {
+    if (!node) {
+        return;
+    }
+    assert(size > 0);
+
+    node->~T();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = free_list;
+    free_list = slot;
+    size--;
+}
+
+
+// Время работы: O(1)
+template<typename T>
+size_t NodePool<T>::Size() const {
+    return size;
+}
+
+
+#endif //COMMON_NODE_POOL_H
@@ -0,0 +1,54 @@
+// Случайные числа из диапазона, одинаковые во всех стандартных библиотеках.
+//
+// Генератор std::mt19937_64 выдает одну и ту же последовательность везде, а
+// алгоритмы std::uniform_int_distribution и std::uniform_real_distribution
+// стандартом не зафиксированы: libstdc++, libc++ и MSVC по одному seed дают
+// разные числа. Поэтому числа получаются из выхода генератора напрямую:
+// целые - умножением со сдвигом (multiply-shift), вещественные - из старших
+// 53 бит.
+
+
+#ifndef COMMON_PORTABLE_RANDOM_H
+#define COMMON_PORTABLE_RANDOM_H
+
+
+#include <cassert>
+#include <cstdint>
+#include <random>
+
+
+// Случайное целое число из [0, range), 0 < range <= 2^32: старшие 32 бита
+// выхода генератора умножаются на range, и берутся старшие 32 бита
+// произведения
+// Время работы: O(1)
+inline uint64_t RandomBelow(std::mt19937_64 &generator, uint64_t range) {
+    assert((range > 0) && (range <= (static_cast<uint64_t>(1) << 32)));
+
+    return ((generator() >> 32) * range) >> 32;
+}
+
+
+// Случайное целое число из [min_value, max_value]
+// Время работы: O(1)
+inline int64_t RandomInRange(std::mt19937_64 &generator, int64_t min_value,
+                             int64_t max_value) {
+    assert(min_value <= max_value);
+
+    const uint64_t range = static_cast<uint64_t>(max_value) -
+                           static_cast<uint64_t>(min_value) + 1;
+    return min_value + static_cast<int64_t>(RandomBelow(generator, range));
+}
+
+
+// Случайное вещественное число из [min_value, max_value)
+// Время работы: O(1)
+inline double RandomReal(std::mt19937_64 &generator, double min_value,
+                         double max_value) {
+    // 2^53 - количество различных значений мантиссы double
+    const double unit = (generator() >> 11) / 9007199254740992.0;
+
+    return min_value + (max_value - min_value) * unit;
+}
+
+
+#endif //COMMON_PORTABLE_RANDOM_H
@@ -0,0 +1,129 @@
+// Выполнение потока команд над множеством строк пакетами.
+//
+// Команда - символ операции ('+', '-', '?') и строка. SetCommandEngine
+// читает пакет из batch_size команд, вычисляет хэши всех строк пакета и
+// запрашивает предвыборку ячеек таблицы, в которые они попадут, а затем
+// выполняет команды по порядку. Пока выполняются первые команды пакета,
+// ячейки следующих уже загружаются в кэш, поэтому задержки обращений к
+// памяти перекрываются. Результаты ("OK" или "FAIL") пишутся в один буфер
+// вывода, который сбрасывается после каждого пакета.
+//
+// Команды выполняются строго в исходном порядке, а предвыборка - только
+// подсказка процессору, поэтому вывод совпадает с выполнением команд по
+// одной.
+//
+// Множество TSet должно иметь методы:
+// size_t GetBaseHash(const string &key) - хэш строки;
+// void Prefetch(size_t hash) - предвыборка ячеек для хэша;
+// bool Has(key, hash), bool Add(key, hash), bool Remove(key, hash).
+
+
+#ifndef COMMON_SET_COMMAND_ENGINE_H
+#define COMMON_SET_COMMAND_ENGINE_H
+
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "fast_input.h"
+#include "fast_output.h"
+
+
+template<typename TSet>
+class SetCommandEngine {
+private:
+    TSet &set;
+    // Количество команд в пакете
+    const size_t batch_size;
+    // Команды текущего пакета (строки переиспользуются между пакетами)
+    std::vector<char> types;
+    std::vector<std::string> keys;
+    std::vector<size_t> hashes;
+
+    // Прочитать очередной пакет, вернуть количество прочитанных команд
+    size_t ReadBatch(FastInput &input);
+
+    // Выполнить команду с номером i пакета
+    bool Execute(size_t i);
+
+public:
+    explicit SetCommandEngine(TSet &set_, size_t batch_size_ = 256);
+
+    // Констурктор копирования
+    SetCommandEngine(const SetCommandEngine &) = delete;
+
+    // Конструктор перемещения
+    SetCommandEngine(SetCommandEngine &&) = delete;
+
+    // Оператор присваивания копированием
+    SetCommandEngine &operator=(const SetCommandEngine &) = delete;
+
+    // Оператор присваивания перемещением
+    SetCommandEngine &operator=(SetCommandEngine &&) = delete;
+
+    // Выполнить все команды из input и вывести результаты в output
+    void Run(FastInput &input, FastOutput &output);
+};
+
+
+template<typename TSet>
+SetCommandEngine<TSet>::SetCommandEngine(TSet &set_, size_t batch_size_)
+        : set(set_), batch_size(batch_size_), types(batch_size_),
+          keys(batch_size_), hashes(batch_size_) {
+    assert(batch_size > 0);
+}
+
+
+// Время работы: O(суммарная длина строк пакета)
+template<typename TSet>
+size_t SetCommandEngine<TSet>::ReadBatch(FastInput &input) {
+    size_t n = 0;
+    while ((n < batch_size) && input.ReadChar(types[n]) &&
+           input.ReadToken(keys[n])) {
+        n++;
+    }
+
+    return n;
+}
+
+
+// Среднее время работы: O(1)
+template<typename TSet>
+bool SetCommandEngine<TSet>::Execute(size_t i) {
+    switch (types[i]) {
+        case '?':
+            return set.Has(keys[i], hashes[i]);
+        case '+':
+            return set.Add(keys[i], hashes[i]);
+        case '-':
+            return set.Remove(keys[i], hashes[i]);
+        default:
+            return false;
+    }
+}
+
+
+// Среднее время работы: O(количество команд + суммарная длина строк)
+template<typename TSet>
+void SetCommandEngine<TSet>::Run(FastInput &input, FastOutput &output) {
+    for (size_t n = ReadBatch(input); n > 0; n = ReadBatch(input)) {
+        for (size_t i = 0; i < n; i++) {
+            hashes[i] = set.GetBaseHash(keys[i]);
+            set.Prefetch(hashes[i]);
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (Execute(i)) {
+                output.Write("OK\n", 3);
+            } else {
+                output.Write("FAIL\n", 5);
+            }
+        }
+        output.Flush();
+    }
+}
+
+
+#endif //COMMON_SET_COMMAND_ENGINE_H
@@ -0,0 +1,208 @@
+// Хранилище строк в больших страницах памяти.
+//
+// Строки дописываются в конец текущей страницы, поэтому на каждую строку не
+// выделяется отдельная память, а соседние по времени добавления строки лежат
+// рядом. Вместо std::string владелец хранит StringRef (номер страницы,
+// смещение, длина). Удаленные строки не освобождаются по одной: арена
+// только считает их байты, и владелец может переложить живые строки в новую
+// арену (Compact), когда мертвых байтов становится много. Вся память арены
+// освобождается сразу в Clear или в деструкторе.
+
+
+#ifndef COMMON_STRING_ARENA_H
+#define COMMON_STRING_ARENA_H
+
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// Ссылка на строку в арене. Поля без инициализаторов, чтобы массивы ссылок
+// можно было выделять без заполнения; StringRef() - нулевая ссылка
+struct StringRef {
+    uint32_t page;
+    uint32_t offset;
+    uint32_t length;
+};
+
+
+class StringArena {
+private:
+    // Размер обычной страницы. Строки длиннее max_small_length получают
+    // собственную страницу, чтобы не оставлять в обычных страницах
+    // неиспользуемые хвосты
+    static const size_t page_size = 1 << 16;
+    static const size_t max_small_length = page_size / 4;
+
+    std::vector<std::unique_ptr<char[]>> pages;
+    // Номер обычной страницы, в которую дописываются строки (-1 - нет такой)
+    size_t current_page;
+    // Количество занятых байтов текущей страницы
+    size_t current_offset;
+    // Суммарная длина живых и удаленных строк
+    size_t live_size;
+    size_t dead_size;
+
+    // Выделить страницу размера size, вернуть ее номер
+    size_t AllocatePage(size_t size);
+
+public:
+    StringArena();
+
+    // Констурктор копирования
+    StringArena(const StringArena &) = delete;
+
+    // Конструктор перемещения
+    StringArena(StringArena &&) = default;
+
+    // Оператор присваивания копированием
+    StringArena &operator=(const StringArena &) = delete;
+
+    // Оператор присваивания перемещением
+    StringArena &operator=(StringArena &&) = default;
+
+    // Скопировать строку в арену
+    StringRef Add(const char *data, size_t length);
+
+    StringRef Add(const std::string &str);
+
+    // Пометить строку удаленной (память освобождается в Compact или Clear)
+    void Release(StringRef ref);
+
+    // Указатель на первый символ строки
+    const char *GetData(StringRef ref) const;
+
+    std::string ToString(StringRef ref) const;
+
+    bool IsEqual(StringRef ref, const std::string &str) const;
+
+    // Скопировать строку ref в арену other (для переноса живых строк)
+    StringRef CopyTo(StringRef ref, StringArena &other) const;
+
+    // Выгодно ли переложить живые строки в новую арену
+    bool IsCompactionNeeded() const;
+
+    // Освободить всю память арены
+    void Clear();
+
+    size_t GetLiveSize() const;
+
+    size_t GetDeadSize() const;
+};
+
+
+inline StringArena::StringArena() : current_page(-1), current_offset(0),
+                                    live_size(0), dead_size(0) {}
+
+
+// Время работы: O(1) (без учета выделения памяти)
+inline size_t StringArena::AllocatePage(size_t size) {
+    pages.emplace_back(new char[size]);
+
+    return pages.size() - 1;
+}
+
+
+// Амортизированное время работы: O(length)
+inline StringRef StringArena::Add(const char *data, size_t length) {
+    assert(length <= UINT32_MAX);
+    StringRef ref;
+    ref.length = static_cast<uint32_t>(length);
+
+    if (length > max_small_length) {
+        ref.page = static_cast<uint32_t>(AllocatePage(length));
+        ref.offset = 0;
+    } else {
+        if ((current_page == static_cast<size_t>(-1)) ||
+            (current_offset + length > page_size)) {
+            current_page = AllocatePage(page_size);
+            current_offset = 0;
+        }
+
+        ref.page = static_cast<uint32_t>(current_page);
+        ref.offset = static_cast<uint32_t>(current_offset);
+        current_offset += length;
+    }
+
+    std::memcpy(pages[ref.page].get() + ref.offset, data, length);
+    live_size += length;
+    return ref;
+}
+
+
+// Амортизированное время работы: O(str.size())
+inline StringRef StringArena::Add(const std::string &str) {
+    return Add(str.data(), str.size());
+}
+
+
+// Время работы: O(1)
+inline void StringArena::Release(StringRef ref) {
+    assert(live_size >= ref.length);
+
+    live_size -= ref.length;
+    dead_size += ref.length;
+}
+
+
+// Время работы: O(1)
+inline const char *StringArena::GetData(StringRef ref) const {
+    assert(ref.page < pages.size());
+
+    return pages[ref.page].get() + ref.offset;
+}
+
+
+// Время работы: O(ref.length)
+inline std::string StringArena::ToString(StringRef ref) const {
+    return std::string(GetData(ref), ref.length);
+}
+
+
+// Время работы: O(min(ref.length, str.size()))
+inline bool StringArena::IsEqual(StringRef ref, const std::string &str) const {
+    return (ref.length == str.size()) &&
+           (std::memcmp(GetData(ref), str.data(), str.size()) == 0);
+}
+
+
+// Амортизированное время работы: O(ref.length)
+inline StringRef StringArena::CopyTo(StringRef ref, StringArena &other) const {
+    return other.Add(GetData(ref), ref.length);
+}
+
+
+// Время работы: O(1)
+inline bool StringArena::IsCompactionNeeded() const {
+    // Мертвых байтов больше, чем живых, и больше одной страницы
+    return (dead_size > live_size) && (dead_size > page_size);
+}
+
+
+// Время работы: O(количество страниц)
+inline void StringArena::Clear() {
+    pages.clear();
+    current_page = -1;
+    current_offset = 0;
+    live_size = 0;
+    dead_size = 0;
+}
+
+
+// Время работы: O(1)
+inline size_t StringArena::GetLiveSize() const {
+    return live_size;
+}
+
+
+// Время работы: O(1)
+inline size_t StringArena::GetDeadSize() const {
+    return dead_size;
+}
+
+
+#endif //COMMON_STRING_ARENA_H
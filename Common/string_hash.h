@@ -0,0 +1,46 @@
+// Хэш строки, обрабатывающий символы по 8 за раз.
+//
+// Строка читается 8-байтовыми словами (последнее слово дополняется нулями),
+// каждое слово смешивается с хэшем умножением на нечетную 64-битную
+// константу. В конце биты еще раз перемешиваются, т.к. хэш-таблицы берут
+// номер ячейки из младших битов. Слова читаются в порядке байтов процессора,
+// поэтому на процессорах с разным порядком байтов хэши различаются.
+
+
+#ifndef COMMON_STRING_HASH_H
+#define COMMON_STRING_HASH_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+// Время работы: O(length)
+inline size_t GetStringHash(const char *data, size_t length) {
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t hash = length * multiplier;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+    if (i < length) {
+        uint64_t word = 0;
+        std::memcpy(&word, data + i, length - i);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    }
+
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 32;
+
+    return static_cast<size_t>(hash);
+}
+
+
+#endif //COMMON_STRING_HASH_H
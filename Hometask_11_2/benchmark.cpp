@@ -0,0 +1,60 @@
+// Бенчмарки подсчета количества кратчайших путей (задача 11_2).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "graph.h"
+
+
+using std::vector;
+
+
+// Случайный граф из n вершин и 4 * n ребер
+static void BM_CountShortestPathsRandom(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<int> ends = GenerateRandomInts(8 * V, 0, V - 1);
+
+    Graph graph(V);
+    for (int i = 0; i < 4 * V; i++) {
+        graph.AddEdge(ends[2 * i], ends[2 * i + 1]);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.CountShortestPaths(0, V - 1));
+    }
+    ReportCounters(state, 5 * static_cast<int64_t>(V));
+}
+BENCHMARK(BM_CountShortestPathsRandom)->Apply(ScaleArguments);
+
+
+// Решетка: между противоположными углами очень много кратчайших путей
+static void BM_CountShortestPathsGrid(benchmark::State &state) {
+    int side = 1;
+    while ((side + 1) * (side + 1) <= state.range(0)) {
+        side++;
+    }
+    const int V = side * side;
+
+    Graph graph(V);
+    for (int row = 0; row < side; row++) {
+        for (int col = 0; col < side; col++) {
+            int v = row * side + col;
+            if (col + 1 < side) {
+                graph.AddEdge(v, v + 1);
+            }
+            if (row + 1 < side) {
+                graph.AddEdge(v, v + side);
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.CountShortestPaths(0, V - 1));
+    }
+    ReportCounters(state, 3 * static_cast<int64_t>(V));
+}
+BENCHMARK(BM_CountShortestPathsGrid)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
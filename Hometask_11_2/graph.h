@@ -0,0 +1,89 @@
+// Невзвешенный неориентированный граф с подсчетом количества кратчайших путей.
+
+
+#ifndef HOMETASK_11_2_GRAPH_H
+#define HOMETASK_11_2_GRAPH_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <vector>
+
+
+class Graph {
+private:
+    struct Vertex {
+        // Глубина текущей вершины во время BFS из начальной вершины
+        int depth;
+        // Количество путей до текущей вершины из начальной вершины
+        int paths;
+
+        Vertex() : depth(0), paths(0) {}
+    };
+
+    std::vector<std::vector<int>> vertices;
+
+public:
+    explicit Graph(int V) : vertices(V) {}
+
+    void AddEdge(int from, int to);
+
+    int CountShortestPaths(int from, int to) const;
+};
+
+
+// Среднее время работы: O(E / V),
+// где V - количество вершин графа, E - количество ребер графа
+inline void Graph::AddEdge(int from, int to) {
+    // Ребро, находящееся в списке смежности, не добавляется повторно, т.е.
+    // кратные ребра отсутствуют
+    auto position = std::find(vertices[from].begin(), vertices[from].end(), to);
+    if (position != vertices[from].end()) {
+        return;
+    }
+
+    // Заполнение списка смежности
+    vertices[from].push_back(to);
+    vertices[to].push_back(from);
+}
+
+
+// Время работы: O(V + E),
+// где V - количество вершин графа, E - количество ребер графа
+inline int Graph::CountShortestPaths(int from, int to) const {
+    // Хранит информацию про посещенные вершины
+    std::vector<Vertex> states(vertices.size());
+    states[from].paths = 1;
+
+    std::queue<int> queue;
+    queue.push(from);
+
+    // BFS из начальной вершины
+    while (!queue.empty()) {
+        int current = queue.front();
+        queue.pop();
+
+        for (int i : vertices[current]) {
+            if (states[i].paths == 0) {
+                // Посещение вершины в первый раз
+                queue.push(i);
+                states[i].depth = states[current].depth + 1;
+                states[i].paths = states[current].paths;
+            } else {
+                // Посещение вершины не в первый раз
+                // Глубина не может отличаться от текущей более чем на 1
+                assert(abs(states[i].depth - states[current].depth) <= 1);
+
+                if (states[i].depth == states[current].depth + 1) {
+                    states[i].paths += states[current].paths;
+                }
+            }
+        }
+    }
+
+    return states[to].paths;
+}
+
+
+#endif //HOMETASK_11_2_GRAPH_H
@@ -0,0 +1,109 @@
+// Бенчмарки поиска мостов (задача 12).
+
+
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "graph.h"
+
+
+using std::thread;
+using std::vector;
+
+
+// Разреженный граф из V вершин: случайное дерево (все ребра - мосты) и V / 2
+// случайных ребер, часть из которых замыкает циклы
+static vector<pair> GenerateSparseGraph(int V) {
+    const vector<int> parents = GenerateRandomInts(V, 0, V - 1);
+    const vector<int> extra = GenerateRandomInts(V, 0, V - 1,
+                                                 benchmark_seed + 1);
+
+    vector<pair> edges;
+    for (int v = 1; v < V; v++) {
+        edges.push_back(pair{v, parents[v] % v});
+    }
+    for (int i = 0; i + 1 < V; i += 2) {
+        edges.push_back(pair{extra[i], extra[i + 1]});
+    }
+
+    return edges;
+}
+
+
+static void BuildGraph(Graph &graph, const vector<pair> &edges) {
+    for (size_t i = 0; i < edges.size(); i++) {
+        graph.AddEdge(edges[i].first, edges[i].second, static_cast<int>(i));
+    }
+}
+
+
+// Построение CSR
+static void BM_BridgesBuild(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<pair> edges = GenerateSparseGraph(V);
+
+    for (auto _ : state) {
+        Graph graph(V);
+        BuildGraph(graph, edges);
+        graph.Build();
+    }
+    ReportCounters(state, static_cast<int64_t>(edges.size()));
+}
+BENCHMARK(BM_BridgesBuild)->Apply(ScaleArguments);
+
+
+// Однопоточный DFS
+static void BM_BridgesDFS(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<pair> edges = GenerateSparseGraph(V);
+    Graph graph(V);
+    BuildGraph(graph, edges);
+    graph.Build();
+
+    for (auto _ : state) {
+        vector<int> bridges;
+        graph.GetBridges(bridges);
+        benchmark::DoNotOptimize(bridges.data());
+    }
+    ReportCounters(state, static_cast<int64_t>(edges.size()));
+}
+BENCHMARK(BM_BridgesDFS)->Apply(ScaleArguments);
+
+
+// Многопоточный поиск по остовному лесу
+static void BM_BridgesParallel(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<pair> edges = GenerateSparseGraph(V);
+    Graph graph(V);
+    BuildGraph(graph, edges);
+    graph.Build();
+    const int n_threads = static_cast<int>(thread::hardware_concurrency());
+
+    for (auto _ : state) {
+        vector<int> bridges;
+        vector<int> articulation_points;
+        graph.GetBridgesParallel(bridges, articulation_points, n_threads);
+        benchmark::DoNotOptimize(bridges.data());
+    }
+    ReportCounters(state, static_cast<int64_t>(edges.size()));
+}
+BENCHMARK(BM_BridgesParallel)->Apply(ScaleArguments)->UseRealTime();
+
+
+// Добавление ребер с поддержкой количества мостов после каждого ребра
+static void BM_BridgesIncremental(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<pair> edges = GenerateSparseGraph(V);
+
+    for (auto _ : state) {
+        Graph graph(V, true);
+        BuildGraph(graph, edges);
+        benchmark::DoNotOptimize(graph.GetBridgesCount());
+    }
+    ReportCounters(state, static_cast<int64_t>(edges.size()));
+}
+BENCHMARK(BM_BridgesIncremental)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
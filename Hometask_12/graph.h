@@ -0,0 +1,854 @@
+// Неориентированный граф с поиском мостов и точек сочленения.
+
+
+#ifndef HOMETASK_12_GRAPH_H
+#define HOMETASK_12_GRAPH_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <stack>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+typedef std::pair<int, int> pair;
+
+
+// Номер ребра для кратных ребер: такое ребро не может быть мостом
+const int multi_edge = -1;
+
+
+// Мосты графа, поддерживаемые при добавлении ребер.
+// Хранится остовный лес, вершинами которого являются компоненты реберной
+// двусвязности (2ECC), тогда каждое ребро леса - мост. Компоненты связности
+// (CC) и 2ECC хранятся в системах непересекающихся множеств. Ребро между
+// разными CC становится мостом и подвешивает меньшее дерево к большему, ребро
+// внутри одной CC стягивает путь между своими концами в одну 2ECC, и все ребра
+// этого пути перестают быть мостами.
+class IncrementalBridges {
+private:
+    // Для представителей 2ECC: родитель в остовном лесе и номер ребра до него
+    std::vector<int> parent;
+    std::vector<int> parent_edge;
+    // Системы непересекающихся множеств для 2ECC и CC
+    std::vector<int> dsu_2ecc;
+    std::vector<int> dsu_cc;
+    std::vector<int> cc_size;
+    // Метки посещения для поиска LCA
+    std::vector<int> last_visit;
+    int lca_iteration;
+    // Пути от концов ребра до LCA (хранятся, чтобы не выделять память заново)
+    std::vector<int> path_a;
+    std::vector<int> path_b;
+    int bridges_count;
+
+    int Find2ECC(int v);
+
+    int FindCC(int v);
+
+    // Перевесить дерево, содержащее v, так, чтобы v стала корнем
+    void MakeRoot(int v);
+
+    // Стянуть путь между a и b в одну 2ECC
+    void MergePath(int a, int b);
+
+public:
+    explicit IncrementalBridges(int V);
+
+    void AddEdge(int from, int to, int edge_n);
+
+    int GetBridgesCount() const;
+
+    // Мосты в возрастающем порядке
+    void GetBridges(std::vector<int> &bridges) const;
+};
+
+
+inline IncrementalBridges::IncrementalBridges(int V) :
+        parent(V, -1), parent_edge(V, -1), dsu_2ecc(V), dsu_cc(V),
+        cc_size(V, 1), last_visit(V, 0), lca_iteration(0), bridges_count(0) {
+    for (int v = 0; v < V; v++) {
+        dsu_2ecc[v] = v;
+        dsu_cc[v] = v;
+    }
+}
+
+
+// Амортизированное время работы: O(α(V))
+inline int IncrementalBridges::Find2ECC(int v) {
+    if (v == -1) {
+        return -1;
+    }
+
+    int root = v;
+    while (dsu_2ecc[root] != root) {
+        root = dsu_2ecc[root];
+    }
+    // Сжатие путей
+    while (dsu_2ecc[v] != root) {
+        int next = dsu_2ecc[v];
+        dsu_2ecc[v] = root;
+        v = next;
+    }
+
+    return root;
+}
+
+
+// Амортизированное время работы: O(α(V))
+inline int IncrementalBridges::FindCC(int v) {
+    v = Find2ECC(v);
+
+    int root = v;
+    while (dsu_cc[root] != root) {
+        root = dsu_cc[root];
+    }
+    // Сжатие путей
+    while (dsu_cc[v] != root) {
+        int next = dsu_cc[v];
+        dsu_cc[v] = root;
+        v = next;
+    }
+
+    return root;
+}
+
+
+// Время работы: O(глубина v в дереве)
+inline void IncrementalBridges::MakeRoot(int v) {
+    v = Find2ECC(v);
+    int root = v;
+    int child = -1;
+    int child_edge = -1;
+
+    // Разворот ребер на пути от v до старого корня
+    while (v != -1) {
+        int p = Find2ECC(parent[v]);
+        int edge = parent_edge[v];
+        parent[v] = child;
+        parent_edge[v] = child_edge;
+        dsu_cc[v] = root;
+
+        child = v;
+        child_edge = edge;
+        v = p;
+    }
+
+    // child - старый корень, хранивший размер компоненты
+    cc_size[root] = cc_size[child];
+}
+
+
+// Время работы: O(длина пути между a и b)
+inline void IncrementalBridges::MergePath(int a, int b) {
+    lca_iteration++;
+    path_a.clear();
+    path_b.clear();
+    int lca = -1;
+
+    // Поочередный подъем от a и от b до первой вершины, посещенной дважды
+    while (lca == -1) {
+        if (a != -1) {
+            a = Find2ECC(a);
+            path_a.push_back(a);
+            if (last_visit[a] == lca_iteration) {
+                lca = a;
+                break;
+            }
+            last_visit[a] = lca_iteration;
+            a = parent[a];
+        }
+
+        if (b != -1) {
+            b = Find2ECC(b);
+            path_b.push_back(b);
+            if (last_visit[b] == lca_iteration) {
+                lca = b;
+                break;
+            }
+            last_visit[b] = lca_iteration;
+            b = parent[b];
+        }
+    }
+
+    // Все ребра на пути до LCA лежат на цикле и перестают быть мостами
+    for (const std::vector<int> *path : {&path_a, &path_b}) {
+        for (int v : *path) {
+            dsu_2ecc[v] = lca;
+            if (v == lca) {
+                break;
+            }
+            bridges_count--;
+        }
+    }
+}
+
+
+// Амортизированное время работы: O(log(V))
+inline void IncrementalBridges::AddEdge(int from, int to, int edge_n) {
+    int a = Find2ECC(from);
+    int b = Find2ECC(to);
+
+    // Ребро внутри одной 2ECC (в том числе петля) ничего не меняет
+    if (a == b) {
+        return;
+    }
+
+    int cc_a = FindCC(a);
+    int cc_b = FindCC(b);
+
+    if (cc_a != cc_b) {
+        // Ребро между разными CC - мост, меньшее дерево подвешивается к
+        // большему
+        bridges_count++;
+        if (cc_size[cc_a] > cc_size[cc_b]) {
+            std::swap(a, b);
+            std::swap(cc_a, cc_b);
+        }
+        MakeRoot(a);
+        parent[a] = b;
+        parent_edge[a] = edge_n;
+        dsu_cc[a] = b;
+        cc_size[cc_b] += cc_size[a];
+    } else {
+        MergePath(a, b);
+    }
+}
+
+
+// Время работы: O(1)
+inline int IncrementalBridges::GetBridgesCount() const {
+    return bridges_count;
+}
+
+
+// Время работы: O(V + B * log(B)), где B - количество мостов
+inline void IncrementalBridges::GetBridges(std::vector<int> &bridges) const {
+    // Мосты - ребра от представителей 2ECC до их родителей в лесе
+    const size_t first = bridges.size();
+    for (size_t v = 0; v < parent.size(); v++) {
+        if ((dsu_2ecc[v] == static_cast<int>(v)) && (parent[v] != -1)) {
+            bridges.push_back(parent_edge[v]);
+        }
+    }
+    std::sort(bridges.begin() + first, bridges.end());
+}
+
+
+class Graph {
+private:
+    // Ребро в том виде, в котором оно пришло на вход
+    struct Edge {
+        int from;
+        int to;
+        int edge_n;
+
+        Edge(int from_, int to_, int edge_n_) :
+                from(from_), to(to_), edge_n(edge_n_) {}
+    };
+
+    // Количество вершин
+    int V;
+    // Режим, в котором мосты обновляются при каждом добавлении ребра
+    bool is_online;
+    IncrementalBridges online_bridges;
+    // Ребра, добавленные до вызова Build
+    std::vector<Edge> pending_edges;
+    // Степени вершин с учетом кратных ребер (нужны для Build)
+    std::vector<int> degrees;
+    bool is_built;
+
+    // Список смежности в формате CSR (compressed sparse row):
+    // смежные с вершиной v вершины лежат в adjacent[offsets[v]] ...
+    // adjacent[offsets[v + 1] - 1], кратные ребра схлопнуты в одно
+    std::vector<int> offsets;
+    std::vector<int> adjacent;
+    // Для каждого элемента adjacent - номер ребра, если ребро входит в граф
+    // один раз, и multi_edge, если ребро кратное
+    std::vector<int> edge_ids;
+
+    void BridgeDFSRecursive(int cur, std::vector<bool> &visited,
+                            std::vector<int> &parent,
+                            std::vector<int> &disc_time,
+                            std::vector<int> &low_time,
+                            std::vector<int> &bridges, int &time) const;
+
+    void BridgeDFSIterative(int cur, std::vector<bool> &visited,
+                            std::vector<int> &parent,
+                            std::vector<int> &disc_time,
+                            std::vector<int> &low_time,
+                            std::vector<int> &bridges, int &time) const;
+
+    // Разбить вершины на n_parts частей с примерно равным числом ребер
+    std::vector<int> SplitVertices(int n_parts) const;
+
+public:
+    // В режиме is_online_ граф не строит CSR: мосты пересчитываются сразу в
+    // AddEdge и доступны в любой момент через GetBridges и GetBridgesCount
+    explicit Graph(int V_, bool is_online_ = false) :
+            V(V_),
+            is_online(is_online_),
+            online_bridges(is_online_ ? V_ : 0),
+            degrees(is_online_ ? 0 : V_, 0),
+            is_built(false) {}
+
+    void AddEdge(int from, int to, int edge_n);
+
+    // Построить CSR по добавленным ребрам, после этого AddEdge недоступен
+    void Build();
+
+    void GetBridges(std::vector<int> &bridges) const;
+
+    // Текущее количество мостов (только в режиме is_online)
+    int GetBridgesCount() const;
+
+    // Многопоточный поиск мостов (в возрастающем порядке) и точек сочленения
+    // (в возрастающем порядке) без DFS
+    void GetBridgesParallel(std::vector<int> &bridges,
+                            std::vector<int> &articulation_points,
+                            int n_threads) const;
+};
+
+
+// Амортизированное время работы: O(1), в режиме is_online - O(log(V))
+inline void Graph::AddEdge(int from, int to, int edge_n) {
+    assert(!is_built);
+
+    if (is_online) {
+        online_bridges.AddEdge(from, to, edge_n);
+        return;
+    }
+
+    // Петля не влияет на мосты: она не может быть мостом и не связывает
+    // вершину ни с какой другой вершиной
+    if (from == to) {
+        return;
+    }
+
+    pending_edges.emplace_back(from, to, edge_n);
+    degrees[from]++;
+    degrees[to]++;
+}
+
+
+// Время работы: O(V + E),
+// где V - количество вершин графа, E - количество ребер графа
+inline void Graph::Build() {
+    assert(!is_built && !is_online);
+
+    // Смещения начала списка каждой вершины по уже посчитанным степеням
+    offsets.assign(V + 1, 0);
+    for (int v = 0; v < V; v++) {
+        offsets[v + 1] = offsets[v] + degrees[v];
+    }
+
+    // Один проход по списку ребер раскладывает их по спискам вершин
+    // (сортировка подсчетом), degrees используется как позиция для записи
+    adjacent.resize(offsets[V]);
+    edge_ids.resize(offsets[V]);
+    for (int v = 0; v < V; v++) {
+        degrees[v] = offsets[v];
+    }
+    for (const Edge &edge : pending_edges) {
+        adjacent[degrees[edge.from]] = edge.to;
+        edge_ids[degrees[edge.from]++] = edge.edge_n;
+        adjacent[degrees[edge.to]] = edge.from;
+        edge_ids[degrees[edge.to]++] = edge.edge_n;
+    }
+    std::vector<Edge>().swap(pending_edges);
+    std::vector<int>().swap(degrees);
+
+    // Схлопывание кратных ребер на месте: last_pos[u] - позиция, куда уже
+    // записана смежная вершина u в списке текущей вершины
+    std::vector<int> last_pos(V, -1);
+    int write = 0;
+    int begin = 0;
+    for (int v = 0; v < V; v++) {
+        int end = offsets[v + 1];
+        offsets[v] = write;
+
+        for (int i = begin; i < end; i++) {
+            int u = adjacent[i];
+            if (last_pos[u] >= offsets[v]) {
+                // Ребро v-u встречается повторно
+                edge_ids[last_pos[u]] = multi_edge;
+            } else {
+                // Ребро v-u встречается в первый раз
+                last_pos[u] = write;
+                adjacent[write] = u;
+                edge_ids[write++] = edge_ids[i];
+            }
+        }
+        begin = end;
+    }
+    offsets[V] = write;
+
+    adjacent.resize(write);
+    adjacent.shrink_to_fit();
+    edge_ids.resize(write);
+    edge_ids.shrink_to_fit();
+    is_built = true;
+}
+
+
+inline void Graph::BridgeDFSRecursive(int cur, std::vector<bool> &visited,
+                                      std::vector<int> &parent,
+                                      std::vector<int> &disc_time,
+                                      std::vector<int> &low_time,
+                                      std::vector<int> &bridges,
+                                      int &time) const {
+    // Факт и время посещения вершины
+    visited[cur] = true;
+    disc_time[cur] = ++time;
+    low_time[cur] = time;
+
+    // Для всех смежных вершин
+    for (int it = offsets[cur]; it < offsets[cur + 1]; it++) {
+        int adj_vertex = adjacent[it];
+
+        if (!visited[adj_vertex]) {
+            // Посещение вершины adj_vertex в первый раз
+            parent[adj_vertex] = cur;
+            BridgeDFSRecursive(adj_vertex, visited, parent, disc_time, low_time,
+                               bridges, time);
+            low_time[cur] = std::min(low_time[cur], low_time[adj_vertex]);
+
+            // Мостом может быть только ребро, входящее в граф один раз
+            int edge_n = edge_ids[it];
+
+            if ((low_time[adj_vertex] > disc_time[cur]) &&
+                (edge_n != multi_edge)) {
+                // Время посещения cur меньше, чем время посещения самой ранней
+                // связанной с adj_vertex не через cur вершины
+                // Значит, adj_vertex связана только с cur, и ребро
+                // cur-adj_vertex - мост
+                bridges.push_back(edge_n);
+            }
+        } else if (adj_vertex != parent[cur]) {
+            // Посещение вершины adj_vertex не в первый раз, и она - не родитель
+            // cur
+            low_time[cur] = std::min(low_time[cur], disc_time[adj_vertex]);
+        }
+    }
+}
+
+
+struct GraphSnapshot {
+    int cur;
+    // Позиция в adjacent, с которой продолжается перебор смежных вершин
+    int it;
+    bool is_first_stage;
+
+    GraphSnapshot(int cur_, int it_, bool is_first_stage_) :
+            cur(cur_),
+            it(it_),
+            is_first_stage(is_first_stage_) {}
+};
+
+
+inline void Graph::BridgeDFSIterative(int cur, std::vector<bool> &visited,
+                                      std::vector<int> &parent,
+                                      std::vector<int> &disc_time,
+                                      std::vector<int> &low_time,
+                                      std::vector<int> &bridges,
+                                      int &time) const {
+    std::stack<GraphSnapshot> stack;
+    stack.emplace(cur, offsets[cur], true);
+
+    while (!stack.empty()) {
+        GraphSnapshot current_snapshot = stack.top();
+        stack.pop();
+
+        cur = current_snapshot.cur;
+        int it = current_snapshot.it;
+
+        if (current_snapshot.is_first_stage) {
+            // До рекурсивного вызова
+            // Факт и время посещения вершины
+            visited[cur] = true;
+            disc_time[cur] = ++time;
+            low_time[cur] = time;
+        } else {
+            // После рекурсивного вызова для смежной вершины adjacent[it]
+            int adj_vertex = adjacent[it];
+            low_time[cur] = std::min(low_time[cur], low_time[adj_vertex]);
+
+            // Мостом может быть только ребро, входящее в граф один раз
+            int edge_n = edge_ids[it];
+
+            if ((low_time[adj_vertex] > disc_time[cur]) &&
+                (edge_n != multi_edge)) {
+                // Время посещения cur меньше, чем время посещения самой ранней
+                // связанной с adj_vertex не через cur вершины
+                // Значит, adj_vertex связана только с cur, и ребро
+                // cur-adj_vertex - мост
+                bridges.push_back(edge_n);
+            }
+            it++;
+        }
+
+        // Для оставшихся смежных вершин
+        for (; it < offsets[cur + 1]; it++) {
+            int adj_vertex = adjacent[it];
+
+            if (!visited[adj_vertex]) {
+                // Посещение вершины adj_vertex в первый раз
+                parent[adj_vertex] = cur;
+
+                // Добавление на стек текущего состояния для продолжения
+                // после возвращения из рекурсивного вызова
+                stack.emplace(cur, it, false);
+
+                // Добавление на стек нового состояния для следующего
+                // рекурсивного вызова
+                stack.emplace(adj_vertex, offsets[adj_vertex], true);
+                break;
+            } else if (adj_vertex != parent[cur]) {
+                // Посещение вершины adj_vertex не в первый раз, и она - не
+                // родитель cur
+                low_time[cur] = std::min(low_time[cur], disc_time[adj_vertex]);
+            }
+        }
+    }
+}
+
+
+// Время работы: O(V + E),
+// где V - количество вершин графа, E - количество ребер графа
+inline void Graph::GetBridges(std::vector<int> &bridges) const {
+    if (is_online) {
+        online_bridges.GetBridges(bridges);
+        return;
+    }
+    assert(is_built);
+
+    // Для каждой вершины в векторах содержится информация:
+    // visited - флаг посещения (была ли вершина посещена хоть раз)
+    // parent - родительская вершина во время DFS
+    // disc_time - время первого посещения
+    // low_time - время посещения самой ранней связанной не через родителя
+    // вершины
+
+    std::vector<bool> visited(V, false);
+    std::vector<int> parent(V, -1);
+    std::vector<int> disc_time(V);
+    std::vector<int> low_time(V);
+
+    // time - счетчик времени (количество итераций)
+    int time = 0;
+
+    for (int i = 0; i < V; i++) {
+        if (!visited[i]) {
+//            BridgeDFSIterative(i, visited, parent, disc_time, low_time,
+//                               bridges, time);
+            BridgeDFSRecursive(i, visited, parent, disc_time, low_time,
+                               bridges, time);
+        }
+    }
+}
+
+
+// Время работы: O(1)
+inline int Graph::GetBridgesCount() const {
+    assert(is_online);
+
+    return online_bridges.GetBridgesCount();
+}
+
+
+// Система непересекающихся множеств, допускающая одновременные объединения из
+// нескольких потоков без блокировок: корень подвешивается к корню с меньшим
+// номером через compare_exchange, поэтому циклы невозможны
+class ConcurrentDSU {
+private:
+    std::vector<std::atomic<int>> parent;
+
+public:
+    explicit ConcurrentDSU(int n);
+
+    int Find(int x);
+
+    // false - если a и b уже были в одном множестве
+    bool Unite(int a, int b);
+};
+
+
+inline ConcurrentDSU::ConcurrentDSU(int n) : parent(n) {
+    for (int i = 0; i < n; i++) {
+        parent[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+
+// Амортизированное время работы: O(log(n))
+inline int ConcurrentDSU::Find(int x) {
+    int p = parent[x].load(std::memory_order_acquire);
+    while (p != x) {
+        // Сокращение пути вдвое: если другой поток успел изменить parent[x],
+        // то неудачный compare_exchange просто пропускается
+        int grandparent = parent[p].load(std::memory_order_acquire);
+        if (grandparent != p) {
+            parent[x].compare_exchange_weak(p, grandparent,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed);
+        }
+        x = p;
+        p = parent[x].load(std::memory_order_acquire);
+    }
+
+    return x;
+}
+
+
+// Амортизированное время работы: O(log(n))
+inline bool ConcurrentDSU::Unite(int a, int b) {
+    while (true) {
+        a = Find(a);
+        b = Find(b);
+        if (a == b) {
+            return false;
+        }
+
+        if (a < b) {
+            std::swap(a, b);
+        }
+
+        // Подвешивание удается, только если a все еще корень
+        int expected = a;
+        if (parent[a].compare_exchange_strong(expected, b,
+                                              std::memory_order_acq_rel)) {
+            return true;
+        }
+    }
+}
+
+
+// Запустить func(part, begin, end) для всех частей [bounds[part];
+// bounds[part + 1]), нулевая часть выполняется в текущем потоке
+template<typename TFunction>
+void RunParallel(const std::vector<int> &bounds, const TFunction &func) {
+    std::vector<std::thread> threads;
+    for (size_t part = 1; part + 1 < bounds.size(); part++) {
+        threads.emplace_back(func, part, bounds[part], bounds[part + 1]);
+    }
+    func(0, bounds[0], bounds[1]);
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+
+
+// Время работы: O(n_parts * log(V))
+inline std::vector<int> Graph::SplitVertices(int n_parts) const {
+    // Части содержат примерно одинаковое количество элементов adjacent
+    std::vector<int> bounds(n_parts + 1, V);
+    bounds[0] = 0;
+    for (int part = 1; part < n_parts; part++) {
+        int64_t target = static_cast<int64_t>(offsets[V]) * part / n_parts;
+        bounds[part] = static_cast<int>(std::lower_bound(
+                offsets.begin(), offsets.end(), target) - offsets.begin());
+        bounds[part] = std::max(std::min(bounds[part], V), bounds[part - 1]);
+    }
+
+    return bounds;
+}
+
+
+// Время работы: O((V + E) / n_threads + V),
+// где V - количество вершин графа, E - количество ребер графа
+inline void Graph::GetBridgesParallel(std::vector<int> &bridges,
+                                      std::vector<int> &articulation_points,
+                                      int n_threads) const {
+    // Вместо DFS используется произвольный остовный лес (Tarjan, Vishkin):
+    // ребро дерева parent-v - мост, если из поддерева v нет обратных ребер
+    // за пределы поддерева. Для этого вершины нумеруются в порядке обхода
+    // дерева (pre), и для каждого поддерева считаются минимальный (low) и
+    // максимальный (high) номера вершин, достижимых одним недревесным ребром
+    assert(is_built);
+    n_threads = std::max(n_threads, 1);
+    const std::vector<int> bounds = SplitVertices(n_threads);
+
+    // 1. Остовный лес: ребро попадает в лес, если оно объединило две
+    // компоненты. Для каждого ребра леса запоминается пара {вершина,
+    // позиция в adjacent}
+    ConcurrentDSU components(V);
+    std::vector<std::vector<pair>> forest_parts(n_threads);
+    RunParallel(bounds, [&](int part, int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            for (int it = offsets[v]; it < offsets[v + 1]; it++) {
+                if ((v < adjacent[it]) && components.Unite(v, adjacent[it])) {
+                    forest_parts[part].push_back(pair{v, it});
+                }
+            }
+        }
+    });
+
+    // 2. Список смежности леса в формате CSR
+    std::vector<int> forest_offsets(V + 1, 0);
+    for (const auto &forest_part : forest_parts) {
+        for (const pair &edge : forest_part) {
+            forest_offsets[edge.first + 1]++;
+            forest_offsets[adjacent[edge.second] + 1]++;
+        }
+    }
+    for (int v = 0; v < V; v++) {
+        forest_offsets[v + 1] += forest_offsets[v];
+    }
+
+    // Для каждого элемента forest_adjacent - позиция ребра в adjacent
+    std::vector<int> forest_adjacent(forest_offsets[V]);
+    std::vector<int> forest_positions(forest_offsets[V]);
+    std::vector<int> fill(forest_offsets.begin(), forest_offsets.end() - 1);
+    for (auto &forest_part : forest_parts) {
+        for (const pair &edge : forest_part) {
+            int from = edge.first;
+            int to = adjacent[edge.second];
+            forest_adjacent[fill[from]] = to;
+            forest_positions[fill[from]++] = edge.second;
+            forest_adjacent[fill[to]] = from;
+            forest_positions[fill[to]++] = edge.second;
+        }
+        std::vector<pair>().swap(forest_part);
+    }
+
+    // 3. Подвешивание деревьев и нумерация вершин в порядке обхода:
+    // pre - номер вершины, order - вершина по номеру, tree_parent - родитель
+    // в дереве, parent_edge - номер ребра до родителя
+    std::vector<int> pre(V, -1);
+    std::vector<int> order(V);
+    std::vector<int> tree_parent(V, -1);
+    std::vector<int> parent_edge(V, multi_edge);
+    std::vector<int> stack;
+    int counter = 0;
+
+    for (int root = 0; root < V; root++) {
+        if (pre[root] != -1) {
+            continue;
+        }
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            pre[v] = counter;
+            order[counter++] = v;
+
+            for (int it = forest_offsets[v]; it < forest_offsets[v + 1]; it++) {
+                int child = forest_adjacent[it];
+                if (child != tree_parent[v]) {
+                    tree_parent[child] = v;
+                    parent_edge[child] = edge_ids[forest_positions[it]];
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+    std::vector<int>().swap(forest_positions);
+
+    // 4. Номера вершин, достижимых из самой вершины недревесными ребрами
+    std::vector<int> low(V);
+    std::vector<int> high(V);
+    RunParallel(bounds, [&](int /*part*/, int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            low[v] = high[v] = pre[v];
+            for (int it = offsets[v]; it < offsets[v + 1]; it++) {
+                int u = adjacent[it];
+                if ((u != tree_parent[v]) && (tree_parent[u] != v)) {
+                    low[v] = std::min(low[v], pre[u]);
+                    high[v] = std::max(high[v], pre[u]);
+                }
+            }
+        }
+    });
+
+    // 5. Подъем low, high и размеров поддеревьев от листьев к корням
+    std::vector<int> subtree_size(V, 1);
+    for (int i = V - 1; i >= 0; i--) {
+        int v = order[i];
+        int p = tree_parent[v];
+        if (p != -1) {
+            low[p] = std::min(low[p], low[v]);
+            high[p] = std::max(high[p], high[v]);
+            subtree_size[p] += subtree_size[v];
+        }
+    }
+
+    // 6. Мосты: из поддерева v нет недревесных ребер наружу, и ребро до
+    // родителя не кратное
+    std::vector<std::vector<int>> bridge_parts(n_threads);
+    RunParallel(bounds, [&](int part, int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            if ((tree_parent[v] != -1) && (parent_edge[v] != multi_edge) &&
+                (low[v] >= pre[v]) && (high[v] < pre[v] + subtree_size[v])) {
+                bridge_parts[part].push_back(parent_edge[v]);
+            }
+        }
+    });
+
+    // 7. Точки сочленения: ребра дерева (обозначаются нижней вершиной)
+    // объединяются в компоненты двусвязности. Вершина - точка сочленения,
+    // если инцидентные ей ребра дерева лежат в разных компонентах
+    ConcurrentDSU blocks(V);
+    RunParallel(bounds, [&](int /*part*/, int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            // Недревесное ребро v-u, где u - не потомок v: ребра до
+            // родителей v и u лежат на одном цикле
+            for (int it = offsets[v]; it < offsets[v + 1]; it++) {
+                int u = adjacent[it];
+                if ((u != tree_parent[v]) && (tree_parent[u] != v) &&
+                    (pre[v] < pre[u]) &&
+                    (pre[u] >= pre[v] + subtree_size[v])) {
+                    blocks.Unite(v, u);
+                }
+            }
+
+            // Ребра p-v и parent(p)-p лежат на одном цикле, если из
+            // поддерева v есть недревесное ребро за пределы поддерева p
+            int p = tree_parent[v];
+            if ((p != -1) && (tree_parent[p] != -1) &&
+                ((low[v] < pre[p]) ||
+                 (high[v] >= pre[p] + subtree_size[p]))) {
+                blocks.Unite(v, p);
+            }
+        }
+    });
+
+    std::vector<std::vector<int>> point_parts(n_threads);
+    RunParallel(bounds, [&](int part, int begin, int end) {
+        for (int v = begin; v < end; v++) {
+            // Компонента ребра до родителя или первого ребра до ребенка
+            int block = (tree_parent[v] != -1) ? blocks.Find(v) : -1;
+
+            for (int it = forest_offsets[v]; it < forest_offsets[v + 1]; it++) {
+                int child = forest_adjacent[it];
+                if (child == tree_parent[v]) {
+                    continue;
+                }
+                if (block == -1) {
+                    block = blocks.Find(child);
+                } else if (blocks.Find(child) != block) {
+                    point_parts[part].push_back(v);
+                    break;
+                }
+            }
+        }
+    });
+
+    for (const auto &bridge_part : bridge_parts) {
+        bridges.insert(bridges.end(), bridge_part.begin(), bridge_part.end());
+    }
+    std::sort(bridges.begin(), bridges.end());
+
+    for (const auto &point_part : point_parts) {
+        articulation_points.insert(articulation_points.end(),
+                                   point_part.begin(), point_part.end());
+    }
+}
+
+
+#endif //HOMETASK_12_GRAPH_H
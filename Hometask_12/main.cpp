@@ -25,22 +25,32 @@
 
 #include <algorithm>
 #include <fstream>
-#include <stack>
+#include <iostream>
+#include <random>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <utility>
+#include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "graph.h"
+#include "portable_random.h"
+
 
 using std::fstream;
 using std::min;
+using std::runtime_error;
 using std::string;
-using std::unordered_map;
+using std::thread;
 using std::vector;
 
 
-typedef std::pair<int, int> pair;
-typedef unordered_map<int, pair>::const_iterator map_iter;
+// Количество ребер, начиная с которого мосты ищутся многопоточно
+const int parallel_min_edges = 1000000;
 
 
 struct IInputStream {
@@ -61,9 +71,227 @@ struct IInputStream {
 
         return pair{from, to};
     }
+
+    // Прочитать n_edges пар подряд (чтение однопоточное)
+    void ReadEdges(int n_edges, vector<pair> &edges, int /*n_threads*/) {
+        edges.reserve(n_edges);
+        for (int i = 0; i < n_edges; i++) {
+            edges.push_back(Read());
+        }
+    }
+};
+
+
+// Поток ввода, отображающий файл в память: числа разбираются прямо в
+// отображенном буфере, без копирования и без аллокаций на каждое ребро
+class MappedInputStream {
+private:
+    // Минимальный размер части файла, ради которой стоит заводить поток
+    static const size_t min_chunk_size = 1 << 20;
+
+    char *data;
+    size_t size;
+    // Текущая позиция последовательного чтения
+    const char *pos;
+
+    // Прочитать натуральное число, начиная с pos, false - если чисел больше нет
+    static bool ParseNumber(const char *&pos, const char *end, int &value);
+
+    // Количество чисел в [begin; end)
+    static int CountNumbers(const char *begin, const char *end);
+
+    // Разобрать все пары из [begin; end) в edges, начиная с позиции first
+    // (не более чем до позиции last)
+    static void ParseEdges(const char *begin, const char *end,
+                           vector<pair> &edges, int first, int last);
+
+public:
+    explicit MappedInputStream(const string &filename);
+
+    ~MappedInputStream();
+
+    // Констурктор копирования
+    MappedInputStream(const MappedInputStream &) = delete;
+
+    // Конструктор перемещения
+    MappedInputStream(MappedInputStream &&) = delete;
+
+    // Оператор присваивания копированием
+    MappedInputStream &operator=(const MappedInputStream &) = delete;
+
+    // Оператор присваивания перемещением
+    MappedInputStream &operator=(MappedInputStream &&) = delete;
+
+    pair Read();
+
+    // Прочитать n_edges пар подряд, разбивая файл на части по границам строк
+    // и разбирая части в n_threads потоков. Порядок пар совпадает с порядком
+    // строк в файле, т.е. i-я пара - ребро номер i
+    void ReadEdges(int n_edges, vector<pair> &edges, int n_threads);
 };
 
 
+MappedInputStream::MappedInputStream(const string &filename) :
+        data(nullptr), size(0), pos(nullptr) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Cannot open " + filename);
+    }
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw runtime_error("Cannot stat " + filename);
+    }
+
+    size = st.st_size;
+    if (size > 0) {
+        void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            close(fd);
+            throw runtime_error("Cannot mmap " + filename);
+        }
+        data = static_cast<char *>(addr);
+        madvise(data, size, MADV_SEQUENTIAL);
+    }
+
+    // Отображение остается действительным и после закрытия дескриптора
+    close(fd);
+    pos = data;
+}
+
+
+MappedInputStream::~MappedInputStream() {
+    if (data) {
+        munmap(data, size);
+    }
+}
+
+
+// Время работы: O(длина числа + количество пропущенных символов)
+bool MappedInputStream::ParseNumber(const char *&pos, const char *end,
+                                    int &value) {
+    while ((pos != end) && ((*pos < '0') || (*pos > '9'))) {
+        pos++;
+    }
+    if (pos == end) {
+        return false;
+    }
+
+    value = 0;
+    while ((pos != end) && (*pos >= '0') && (*pos <= '9')) {
+        value = value * 10 + (*pos - '0');
+        pos++;
+    }
+
+    return true;
+}
+
+
+// Время работы: O(end - begin)
+int MappedInputStream::CountNumbers(const char *begin, const char *end) {
+    int count = 0;
+    bool in_number = false;
+
+    for (; begin != end; begin++) {
+        bool is_digit = (*begin >= '0') && (*begin <= '9');
+        count += (is_digit && !in_number);
+        in_number = is_digit;
+    }
+
+    return count;
+}
+
+
+// Время работы: O(end - begin)
+void MappedInputStream::ParseEdges(const char *begin, const char *end,
+                                   vector<pair> &edges, int first, int last) {
+    int from = 0, to = 0;
+    for (int i = first; i < last; i++) {
+        if (!ParseNumber(begin, end, from) || !ParseNumber(begin, end, to)) {
+            break;
+        }
+        edges[i] = pair{from, to};
+    }
+}
+
+
+// Время работы: O(длина строки)
+pair MappedInputStream::Read() {
+    const char *end = data + size;
+    int from = 0, to = 0;
+    ParseNumber(pos, end, from);
+    ParseNumber(pos, end, to);
+
+    return pair{from, to};
+}
+
+
+// Время работы: O(size / n_threads)
+void MappedInputStream::ReadEdges(int n_edges, vector<pair> &edges,
+                                  int n_threads) {
+    const char *end = data + size;
+    edges.assign(n_edges, pair{0, 0});
+
+    // Не заводим потоки ради маленьких частей файла
+    size_t rest = end - pos;
+    size_t max_threads = rest / min_chunk_size + 1;
+    if ((n_threads < 1) || (static_cast<size_t>(n_threads) > max_threads)) {
+        n_threads = (n_threads < 1) ? 1 : static_cast<int>(max_threads);
+    }
+
+    if (n_threads == 1) {
+        ParseEdges(pos, end, edges, 0, n_edges);
+        pos = end;
+        return;
+    }
+
+    // Границы частей выравниваются на начало строки, поэтому каждая пара
+    // целиком лежит в одной части
+    vector<const char *> bounds(n_threads + 1, end);
+    bounds[0] = pos;
+    for (int i = 1; i < n_threads; i++) {
+        const char *bound = pos + rest / n_threads * i;
+        while ((bound != end) && (*(bound - 1) != '\n')) {
+            bound++;
+        }
+        bounds[i] = std::max(bound, bounds[i - 1]);
+    }
+
+    // Первый проход: подсчет пар в каждой части
+    vector<int> first_edge(n_threads + 1, 0);
+    vector<thread> threads;
+    for (int i = 0; i < n_threads; i++) {
+        threads.emplace_back([&bounds, &first_edge, i]() {
+            first_edge[i + 1] = CountNumbers(bounds[i], bounds[i + 1]) / 2;
+        });
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    threads.clear();
+
+    // Префиксные суммы дают номер первого ребра каждой части
+    for (int i = 0; i < n_threads; i++) {
+        first_edge[i + 1] += first_edge[i];
+    }
+
+    // Второй проход: разбор пар прямо в итоговые позиции вектора
+    for (int i = 0; i < n_threads; i++) {
+        int first = min(first_edge[i], n_edges);
+        int last = min(first_edge[i + 1], n_edges);
+        threads.emplace_back([&bounds, &edges, i, first, last]() {
+            ParseEdges(bounds[i], bounds[i + 1], edges, first, last);
+        });
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+
+    pos = end;
+}
+
+
 struct IOutputStream {
     fstream fs;
 
@@ -86,244 +314,209 @@ struct IOutputStream {
 };
 
 
-class Graph {
-private:
-    // Количество вершин
-    int V;
-    // Список смежности:
-    // Индекс вектора - номер вершины
-    // Ключ unordered_map - номер смежной вершины
-    // Значение unordered_map - пара {количество повторений текущего ребра
-    // (кратные ребра), номер, с которым текущее ребро пришло в последний раз}
-    vector<unordered_map<int, pair>> vertices;
-
-    void BridgeDFSRecursive(int cur, vector<bool> &visited,
-                            vector<int> &parent, vector<int> &disc_time,
-                            vector<int> &low_time, vector<int> &bridges,
-                            int &time) const;
-
-    void BridgeDFSIterative(int cur, vector<bool> &visited,
-                            vector<int> &parent, vector<int> &disc_time,
-                            vector<int> &low_time, vector<int> &bridges,
-                            int &time) const;
-
-public:
-    explicit Graph(int V_) : V(V_), vertices(V_) {}
-
-    void AddEdge(int from, int to, int edge_n);
-
-    void GetBridges(vector<int> &bridges) const;
-};
+// Прочитать граф из input, в режиме is_incremental мосты пересчитываются при
+// добавлении каждого ребра
+// Время работы: O(V + E), в режиме is_incremental - O(V + E * log(V))
+template<typename TInputStream>
+void ReadGraph(TInputStream &input, Graph &graph, int &E,
+               bool is_incremental) {
+    // Чтение количества вершин и количества ребер
+    pair VE = input.Read();
+    int V = VE.first;
+    E = VE.second;
+    graph = Graph(V, is_incremental);
 
+    // Чтение ребер
+    vector<pair> edges;
+    input.ReadEdges(E, edges, static_cast<int>(thread::hardware_concurrency()));
 
-// Среднее время работы: O(1)
-void Graph::AddEdge(int from, int to, int edge_n) {
-    // Для вершины from
-    if (vertices[from].find(to) == vertices[from].end()) {
-        // Ребро встречается в первый раз
-        vertices[from][to] = pair{1, edge_n};
-    } else {
-        // Ребро встречается повторно
-        vertices[from][to].first++;
-        vertices[from][to].second = edge_n;
+    for (int i = 0; i < E; i++) {
+        // Уменьшение на единицу, т.к. номера ребер на входе - от 1 до V
+        int from = edges[i].first - 1;
+        int to = edges[i].second - 1;
+        graph.AddEdge(from, to, i);
     }
-
-    // Для вершины to
-    if (vertices[to].find(from) == vertices[to].end()) {
-        // Ребро встречается в первый раз
-        vertices[to][from] = pair{1, edge_n};
-    } else {
-        // Ребро встречается повторно
-        vertices[to][from].first++;
-        vertices[to][from].second = edge_n;
+    vector<pair>().swap(edges);
+    if (!is_incremental) {
+        graph.Build();
     }
 }
 
 
-void Graph::BridgeDFSRecursive(int cur, vector<bool> &visited,
-                               vector<int> &parent, vector<int> &disc_time,
-                               vector<int> &low_time, vector<int> &bridges,
-                               int &time) const {
-    // Факт и время посещения вершины
-    visited[cur] = true;
-    disc_time[cur] = ++time;
-    low_time[cur] = time;
-
-    // Для всех смежных вершин
-    for (auto it = vertices[cur].begin(); it != vertices[cur].end(); it++) {
-        int adj_vertex = it->first;
-
-        if (!visited[adj_vertex]) {
-            // Посещение вершины adj_vertex в первый раз
-            parent[adj_vertex] = cur;
-            BridgeDFSRecursive(adj_vertex, visited, parent, disc_time, low_time,
-                               bridges, time);
-            low_time[cur] = min(low_time[cur], low_time[adj_vertex]);
-
-            // edge_count - количество повторений текущего ребра
-            // edge_n - номер, с которым текущее ребро пришло в последний раз
-            // Мостом может быть только ребро, входящее в граф один раз, поэтому
-            // edge_n для моста - не только последний номер, но и единственный
-            // за все время
-            int edge_count = it->second.first;
-            int edge_n = it->second.second;
-
-            if ((low_time[adj_vertex] > disc_time[cur]) && (edge_count == 1)) {
-                // Время посещения cur меньше, чем время посещения самой ранней
-                // связанной с adj_vertex не через cur вершины
-                // Значит, adj_vertex связана только с cur, и ребро
-                // cur-adj_vertex - мост
-                bridges.push_back(edge_n);
-            }
-        } else if (adj_vertex != parent[cur]) {
-            // Посещение вершины adj_vertex не в первый раз, и она - не родитель
-            // cur
-            low_time[cur] = min(low_time[cur], disc_time[adj_vertex]);
+// Количество компонент связности графа из V вершин и ребер edges без вершины
+// skip_vertex и ребра skip_edge (-1 - ничего не пропускается)
+// Время работы: O(V + E)
+int CountComponents(int V, const vector<pair> &edges, int skip_vertex,
+                    int skip_edge) {
+    vector<vector<int>> adjacent(V);
+    for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+        const int from = edges[i].first;
+        const int to = edges[i].second;
+        if ((i != skip_edge) && (from != skip_vertex) && (to != skip_vertex)) {
+            adjacent[from].push_back(to);
+            adjacent[to].push_back(from);
         }
     }
-}
-
-
-struct GraphSnapshot {
-    int cur;
-    map_iter it;
-    bool is_first_stage;
-
-    GraphSnapshot(int cur_, map_iter it_, bool is_first_stage_) :
-            cur(cur_),
-            it(it_),
-            is_first_stage(is_first_stage_) {}
-};
 
+    int count = 0;
+    vector<bool> visited(V, false);
+    vector<int> stack;
+    for (int v = 0; v < V; v++) {
+        if (visited[v] || (v == skip_vertex)) {
+            continue;
+        }
 
-void Graph::BridgeDFSIterative(int cur, vector<bool> &visited,
-                               vector<int> &parent, vector<int> &disc_time,
-                               vector<int> &low_time, vector<int> &bridges,
-                               int &time) const {
-    std::stack<GraphSnapshot> stack;
-    stack.emplace(cur, vertices[cur].begin(), true);
-
-    while (!stack.empty()) {
-        GraphSnapshot current_snapshot = stack.top();
-        stack.pop();
-
-        if (current_snapshot.is_first_stage) {
-            // До рекурсивного вызова
-            cur = current_snapshot.cur;
-            auto it = current_snapshot.it;
-
-            // Факт и время посещения вершины
-            visited[cur] = true;
-            disc_time[cur] = ++time;
-            low_time[cur] = time;
-
-            // Для всех смежных вершин
-            for (; it != vertices[cur].end(); it++) {
-                int adj_vertex = it->first;
-
-                if (!visited[adj_vertex]) {
-                    // Посещение вершины adj_vertex в первый раз
-                    parent[adj_vertex] = cur;
-
-                    // Добавление на стек текущего состояния для продолжения
-                    // после возвращения из рекурсивного вызова
-                    stack.emplace(cur, it, false);
-
-                    // Добавление на стек нового состояния для следующего
-                    // рекурсивного вызова
-                    stack.emplace(adj_vertex, vertices[adj_vertex].begin(),
-                                  true);
-
-                } else if (adj_vertex != parent[cur]) {
-                    // Посещение вершины adj_vertex не в первый раз, и она - не
-                    // родитель cur
-                    low_time[cur] = min(low_time[cur], disc_time[adj_vertex]);
+        count++;
+        visited[v] = true;
+        stack.push_back(v);
+        while (!stack.empty()) {
+            const int cur = stack.back();
+            stack.pop_back();
+            for (int next : adjacent[cur]) {
+                if (!visited[next]) {
+                    visited[next] = true;
+                    stack.push_back(next);
                 }
             }
-        } else {
-            // После рекурсивного вызова
-            cur = current_snapshot.cur;
-            int adj_vertex = current_snapshot.it->first;
-
-            low_time[cur] = min(low_time[cur], low_time[adj_vertex]);
-
-            // edge_count - количество повторений текущего ребра
-            // edge_n - номер, с которым текущее ребро пришло в последний раз
-            // Мостом может быть только ребро, входящее в граф один раз, поэтому
-            // edge_n для моста - не только последний номер, но и единственный
-            // за все время
-            int edge_count = current_snapshot.it->second.first;
-            int edge_n = current_snapshot.it->second.second;
-
-            if ((low_time[adj_vertex] > disc_time[cur]) && (edge_count == 1)) {
-                // Время посещения cur меньше, чем время посещения самой ранней
-                // связанной с adj_vertex не через cur вершины
-                // Значит, adj_vertex связана только с cur, и ребро
-                // cur-adj_vertex - мост
-                bridges.push_back(edge_n);
-            }
         }
     }
+
+    return count;
 }
 
 
-// Время работы: O(V + E),
-// где V - количество вершин графа, E - количество ребер графа
-void Graph::GetBridges(vector<int> &bridges) const {
-    // Для каждой вершины в векторах содержится информация:
-    // visited - флаг посещения (была ли вершина посещена хоть раз)
-    // parent - родительская вершина во время DFS
-    // disc_time - время первого посещения
-    // low_time - время посещения самой ранней связанной не через родителя
-    // вершины
+// Проверка поиска мостов на маленьких случайных графах (несвязных, с
+// изолированными вершинами, петлями и кратными ребрами): мосты GetBridges,
+// GetBridgesParallel в 1-4 потока и режима is_online сравниваются с перебором
+// (удаление каждого ребра), точки сочленения GetBridgesParallel - с
+// перебором (удаление каждой вершины).
+// Возвращает количество графов, на которых проверка не прошла
+int Test() {
+    const int n_graphs = 2000;
+    const int max_threads = 4;
+    std::mt19937_64 generator(20200214);
+
+    int n_failed = 0;
+    for (int graph_n = 0; graph_n < n_graphs; graph_n++) {
+        const int V = static_cast<int>(RandomInRange(generator, 1, 12));
+        const int E = static_cast<int>(RandomInRange(generator, 0, 2 * V));
+        vector<pair> edges;
+        for (int i = 0; i < E; i++) {
+            // Концы ребер чаще берутся из первой половины вершин, поэтому
+            // остальные вершины часто изолированы или в других компонентах
+            const int range = (RandomInRange(generator, 0, 1) == 0) ?
+                              (V + 1) / 2 : V;
+            edges.push_back(pair{
+                    static_cast<int>(RandomInRange(generator, 0, range - 1)),
+                    static_cast<int>(RandomInRange(generator, 0, range - 1))});
+            if ((i > 0) && (RandomInRange(generator, 0, 9) == 0)) {
+                // Кратное ребро
+                edges.back() = edges[i - 1];
+            }
+        }
 
-    vector<bool> visited(V, false);
-    vector<int> parent(V, -1);
-    vector<int> disc_time(V);
-    vector<int> low_time(V);
-
-    // time - счетчик времени (количество итераций)
-    int time = 0;
-
-    for (int i = 0; i < V; i++) {
-        if (!visited[i]) {
-//            BridgeDFSIterative(i, visited, parent, disc_time, low_time,
-//                               bridges, time);
-            BridgeDFSRecursive(i, visited, parent, disc_time, low_time,
-                               bridges, time);
+        // Ожидаемые мосты и точки сочленения (в возрастающем порядке)
+        const int n_components = CountComponents(V, edges, -1, -1);
+        vector<int> expected_bridges;
+        for (int i = 0; i < E; i++) {
+            if (CountComponents(V, edges, -1, i) > n_components) {
+                expected_bridges.push_back(i);
+            }
+        }
+        vector<int> expected_points;
+        for (int v = 0; v < V; v++) {
+            if (CountComponents(V, edges, v, -1) > n_components) {
+                expected_points.push_back(v);
+            }
+        }
+
+        Graph graph(V);
+        Graph online_graph(V, true);
+        for (int i = 0; i < E; i++) {
+            graph.AddEdge(edges[i].first, edges[i].second, i);
+            online_graph.AddEdge(edges[i].first, edges[i].second, i);
+        }
+        graph.Build();
+
+        vector<int> bridges;
+        graph.GetBridges(bridges);
+        std::sort(bridges.begin(), bridges.end());
+        bool is_passed = (bridges == expected_bridges);
+
+        bridges.clear();
+        online_graph.GetBridges(bridges);
+        is_passed = is_passed && (bridges == expected_bridges);
+
+        for (int n_threads = 1; n_threads <= max_threads; n_threads++) {
+            vector<int> points;
+            bridges.clear();
+            graph.GetBridgesParallel(bridges, points, n_threads);
+            is_passed = is_passed && (bridges == expected_bridges) &&
+                        (points == expected_points);
+        }
+
+        if (!is_passed) {
+            std::cout << "Test failed for graph " << graph_n << ": V = " << V
+                      << ", E = " << E << '\n';
+            n_failed++;
         }
     }
+
+    std::cout << "Tested graphs: " << n_graphs << ", failed: " << n_failed
+              << '\n';
+    return n_failed;
 }
 
 
-int main() {
+// Параметры командной строки:
+// --fstream - читать входной файл через fstream, а не отображением в память
+// --incremental - поддерживать мосты при добавлении каждого ребра
+// (IncrementalBridges) вместо поиска по построенному графу
+// --test - проверить поиск мостов и точек сочленения (Test) вместо решения
+// задачи
+int main(int argc, char *argv[]) {
 //    const string file_folder = "/Users/n.guryev/CLionProjects/Hometask_12/";
     const string file_folder;
     const string in_file = file_folder + "bridges.in";
     const string out_file = file_folder + "bridges.out";
 
-    IInputStream input(in_file);
-    IOutputStream output(out_file);
-
-    // Чтение количества вершин и количества ребер
-    pair VE = input.Read();
-    int V = VE.first;
-    int E = VE.second;
-    Graph graph(V);
-
-    // Чтение ребер
-    for (int i = 0; i < E; i++) {
-        pair from_to = input.Read();
-
-        // Уменьшение на единицу, т.к. номера ребер на входе - от 1 до V
-        int from = from_to.first - 1;
-        int to = from_to.second - 1;
-        graph.AddEdge(from, to, i);
+    bool is_fstream = false;
+    bool is_incremental = false;
+    for (int i = 1; i < argc; i++) {
+        const string option = argv[i];
+        if (option == "--fstream") {
+            is_fstream = true;
+        } else if (option == "--incremental") {
+            is_incremental = true;
+        } else if (option == "--test") {
+            return (Test() == 0) ? 0 : 1;
+        } else {
+            std::cerr << "Unknown option: " << option << '\n';
+            return 1;
+        }
     }
 
-    // Нахождение мостов
+    Graph graph(0);
+    int E = 0;
+    if (is_fstream) {
+        IInputStream input(in_file);
+        ReadGraph(input, graph, E, is_incremental);
+    } else {
+        MappedInputStream input(in_file);
+        ReadGraph(input, graph, E, is_incremental);
+    }
+    IOutputStream output(out_file);
+    // Нахождение мостов: на больших графах - многопоточное, т.к. глубина
+    // рекурсии DFS и время однопоточного обхода становятся неприемлемыми
     vector<int> bridges;
-    graph.GetBridges(bridges);
+    if (!is_incremental && (E >= parallel_min_edges)) {
+        vector<int> articulation_points;
+        graph.GetBridgesParallel(bridges, articulation_points,
+                                 static_cast<int>(
+                                         thread::hardware_concurrency()));
+    } else {
+        graph.GetBridges(bridges);
+    }
 
     // Запись количества мостов
     output.Write(bridges.size());
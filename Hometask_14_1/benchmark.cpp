@@ -0,0 +1,60 @@
+// Бенчмарки поиска минимального остовного дерева (задача 14_1).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "graph.h"
+
+
+using std::vector;
+
+
+// Связный граф из V вершин: путь 0 - 1 - ... - (V - 1) и 3 * V случайных
+// ребер со случайными весами
+static void BM_FindMSTRandom(benchmark::State &state) {
+    const int V = static_cast<int>(state.range(0));
+    const vector<int> ends = GenerateRandomInts(6 * V, 0, V - 1);
+    const vector<int> weights = GenerateRandomInts(4 * V, 1, 100000,
+                                                   benchmark_seed + 1);
+
+    Graph graph(V);
+    for (int v = 0; v + 1 < V; v++) {
+        graph.AddEdge(v, v + 1, weights[v]);
+    }
+    for (int i = 0; i < 3 * V; i++) {
+        graph.AddEdge(ends[2 * i], ends[2 * i + 1], weights[V + i]);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.FindMST());
+    }
+    ReportCounters(state, 4 * static_cast<int64_t>(V));
+}
+BENCHMARK(BM_FindMSTRandom)->Apply(ScaleArguments);
+
+
+// Полный граф: каждая вершина многократно улучшает вес соседей
+static void BM_FindMSTDense(benchmark::State &state) {
+    int V = 1;
+    while ((V + 1) * V / 2 <= state.range(0)) {
+        V++;
+    }
+    const vector<int> weights = GenerateRandomInts(V * V, 1, 100000);
+
+    Graph graph(V);
+    for (int from = 0; from < V; from++) {
+        for (int to = from + 1; to < V; to++) {
+            graph.AddEdge(from, to, weights[from * V + to]);
+        }
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(graph.FindMST());
+    }
+    ReportCounters(state, static_cast<int64_t>(V) * (V - 1) / 2);
+}
+BENCHMARK(BM_FindMSTDense)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
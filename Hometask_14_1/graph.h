@@ -0,0 +1,95 @@
+// Взвешенный неориентированный граф с поиском минимального остовного дерева.
+
+
+#ifndef HOMETASK_14_1_GRAPH_H
+#define HOMETASK_14_1_GRAPH_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "indexed_min_heap.h"
+
+
+const int INT_INF = std::numeric_limits<int>::max();
+typedef std::pair<int, int> pair;
+
+
+class Graph {
+private:
+    std::vector<std::vector<pair>> vertices;
+
+public:
+    explicit Graph(int V) : vertices(V) {}
+
+    void AddEdge(int from, int to, int weight);
+
+    int FindMST() const;
+};
+
+
+// Время работы: O(1)
+inline void Graph::AddEdge(int from, int to, int weight) {
+    vertices[from].push_back(pair{to, weight});
+    vertices[to].push_back(pair{from, weight});
+}
+
+
+// Время работы: O(E * log(V)),
+// где V - количество вершин графа, E - количество ребер графа
+inline int Graph::FindMST() const {
+    // Для каждой вершины в векторах содержится информация:
+    // weights - минимальное расстояние от вершины до построенной части MST
+    // in_mst - используется ли вершина в MST
+
+    std::vector<int> weights(vertices.size(), INT_INF);
+    std::vector<bool> in_mst(vertices.size(), false);
+
+    // Куча содержит просмотренные вершины, которые еще не добавлены в MST,
+    // с ключом weights. Улучшение веса вершины - DecreaseKey, поэтому в
+    // основном цикле память не выделяется. В списке смежности вершины
+    // хранятся пары (номер вершины, вес)
+    IndexedMinHeap<int, std::less<int>, 4> heap(
+            static_cast<int>(vertices.size()));
+
+    // 0 - начальная вершина, имеет вес 0
+    int start_vertex = 0;
+    weights[start_vertex] = 0;
+    heap.Push(start_vertex, weights[start_vertex]);
+
+    while (!heap.Empty()) {
+        int current = heap.Pop();
+        in_mst[current] = true;
+
+        for (const auto &i : vertices[current]) {
+            int label = i.first;
+            int weight = i.second;
+
+            if ((!in_mst[label]) && (weight < weights[label])) {
+                weights[label] = weight;
+                if (heap.Contains(label)) {
+                    heap.DecreaseKey(label, weight);
+                } else {
+                    heap.Push(label, weight);
+                }
+            }
+        }
+    }
+
+    // Теперь weights больше не содержит INT_INF
+    assert(std::count(weights.begin(), weights.end(), INT_INF) == 0);
+
+    int result = 0;
+    for (int i : weights) {
+        result += i;
+    }
+
+    return result;
+}
+
+
+#endif //HOMETASK_14_1_GRAPH_H
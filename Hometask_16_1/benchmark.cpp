@@ -0,0 +1,53 @@
+// Бенчмарки поиска подстроки алгоритмом Кнута-Морриса-Пратта (задача 16_1).
+
+
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "prefix_function.h"
+
+
+using std::string;
+using std::vector;
+
+
+static void RunSearch(benchmark::State &state, const string &pattern,
+                      const string &text) {
+    for (auto _ : state) {
+        vector<size_t> pi(pattern.length());
+        vector<size_t> positions;
+        ComputePrefixFunc(pattern, pi);
+        Search(pattern, text, pi, positions);
+        benchmark::DoNotOptimize(positions.data());
+    }
+    ReportCounters(state, static_cast<int64_t>(text.length()));
+}
+
+
+// Случайный текст над алфавитом {a, b}
+static void BM_SearchRandom(benchmark::State &state) {
+    const string text = GenerateRandomStrings(1, state.range(0),
+                                              state.range(0), 'b')[0];
+    RunSearch(state, "abaab", text);
+}
+BENCHMARK(BM_SearchRandom)->Apply(ScaleArguments);
+
+
+// Вырожденный случай: префикс-функция многократно откатывается
+static void BM_SearchPeriodic(benchmark::State &state) {
+    const string text(state.range(0), 'a');
+    RunSearch(state, string(100, 'a') + "b", text);
+}
+BENCHMARK(BM_SearchPeriodic)->Apply(ScaleArguments);
+
+
+// Каждая позиция текста - вхождение шаблона
+static void BM_SearchAllMatches(benchmark::State &state) {
+    const string text(state.range(0), 'a');
+    RunSearch(state, "aaaa", text);
+}
+BENCHMARK(BM_SearchAllMatches)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
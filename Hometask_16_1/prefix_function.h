@@ -0,0 +1,66 @@
+// Поиск подстроки с помощью префикс-функции (алгоритм Кнута-Морриса-Пратта).
+
+
+#ifndef HOMETASK_16_1_PREFIX_FUNCTION_H
+#define HOMETASK_16_1_PREFIX_FUNCTION_H
+
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+
+// Время работы: O(pattern.length())
+inline void ComputePrefixFunc(const std::string &pattern,
+                              std::vector<size_t> &pi) {
+    pi[0] = 0;
+    size_t j = 0;
+
+    for (size_t i = 1; i < pattern.length(); i++) {
+        while (pattern[i] != pattern[j] && j > 0) {
+            j = pi[j - 1];
+        }
+
+        if (pattern[i] == pattern[j]) {
+            j++;
+        } else {
+            assert(j == 0);
+        }
+
+        pi[i] = j;
+    }
+}
+
+
+// Время работы: O(pattern.length() + text.length())
+inline void Search(const std::string &pattern, const std::string &text,
+                   const std::vector<size_t> &pi,
+                   std::vector<size_t> &positions) {
+    // Алгоритм работает так, как будто pattern и text соединены:
+    // pattern + $ + text, однако в реальности это две различные переменные
+    size_t j = 0;
+
+    for (size_t i = 0; i < text.length(); i++) {
+        assert(j <= pattern.length());
+        // Ленивое вычисление: если j == pattern.length(), то следующее условие
+        // не проверяется
+        while ((j == pattern.length()) || (text[i] != pattern[j] && j > 0)) {
+            j = pi[j - 1];
+        }
+
+        if (text[i] == pattern[j]) {
+            j++;
+        } else {
+            assert(j == 0);
+        }
+
+        // Если префикс-функция для символа из text равняется длине pattern, то
+        // то этот символ - конец вхождения pattern в text
+        if (j == pattern.length()) {
+            positions.push_back(i - pattern.length() + 1);
+        }
+    }
+}
+
+
+#endif //HOMETASK_16_1_PREFIX_FUNCTION_H
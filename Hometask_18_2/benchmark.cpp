@@ -0,0 +1,56 @@
+// Бенчмарки построения выпуклой оболочки алгоритмом Джарвиса (задача 18_2).
+
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "convex_hull.h"
+
+
+using std::vector;
+
+
+static void RunConvexHull(benchmark::State &state,
+                          const vector<Point> &points) {
+    for (auto _ : state) {
+        vector<Point> hull_points;
+        SearchForConvexHull(points, hull_points);
+        benchmark::DoNotOptimize(Perimeter(hull_points));
+    }
+    ReportCounters(state, static_cast<int64_t>(points.size()));
+}
+
+
+// Случайные точки в квадрате: оболочка состоит из O(log(n)) точек
+static void BM_ConvexHullSquare(benchmark::State &state) {
+    std::mt19937_64 generator(benchmark_seed);
+
+    vector<Point> points;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        double x = RandomReal(generator, -1000, 1000);
+        points.emplace_back(x, RandomReal(generator, -1000, 1000));
+    }
+    RunConvexHull(state, points);
+}
+BENCHMARK(BM_ConvexHullSquare)->Apply(ScaleArguments);
+
+
+// Вырожденный случай: все точки на окружности лежат на оболочке, и время
+// работы становится квадратичным
+static void BM_ConvexHullCircle(benchmark::State &state) {
+    const double pi = std::acos(-1.0);
+    const int64_t n = state.range(0);
+
+    vector<Point> points;
+    for (int64_t i = 0; i < n; i++) {
+        double angle = 2 * pi * i / n;
+        points.emplace_back(1000 * std::cos(angle), 1000 * std::sin(angle));
+    }
+    RunConvexHull(state, points);
+}
+BENCHMARK(BM_ConvexHullCircle)->Apply(QuadraticScaleArguments);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+// Бенчмарки очереди на двух стеках и дека на кольцевом буфере (задача 1_3).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "deque.h"
+#include "queue.h"
+
+
+using std::vector;
+
+
+// Все элементы добавляются, затем все извлекаются
+static void BM_QueuePushThenPop(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        Queue queue;
+        for (int value : values) {
+            queue.Push(value);
+        }
+        while (!queue.Empty()) {
+            benchmark::DoNotOptimize(queue.Pop());
+        }
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_QueuePushThenPop)->Apply(ScaleArguments);
+
+
+// Чередование добавлений и извлечений: в правом стеке часто пусто, и
+// элементы перекладываются небольшими порциями
+static void BM_QueueInterleaved(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        Queue queue;
+        for (int i = 0; i < n; i++) {
+            queue.Push(values[i]);
+            if (i % 3 == 2) {
+                benchmark::DoNotOptimize(queue.Pop());
+                benchmark::DoNotOptimize(queue.Pop());
+            }
+        }
+    }
+    ReportCounters(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_QueueInterleaved)->Apply(ScaleArguments);
+
+
+static void BM_DequePushThenPop(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        Deque deque;
+        for (int value : values) {
+            deque.PushBack(value);
+        }
+        while (!deque.Empty()) {
+            benchmark::DoNotOptimize(deque.PopFront());
+        }
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_DequePushThenPop)->Apply(ScaleArguments);
+
+
+static void BM_DequeInterleaved(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        Deque deque;
+        for (int i = 0; i < n; i++) {
+            deque.PushBack(values[i]);
+            if (i % 3 == 2) {
+                benchmark::DoNotOptimize(deque.PopFront());
+                benchmark::DoNotOptimize(deque.PopFront());
+            }
+        }
+    }
+    ReportCounters(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_DequeInterleaved)->Apply(ScaleArguments);
+
+
+// Все четыре команды дека в случайном порядке (буфер заранее расширен, как в
+// main.cpp)
+static void BM_DequeAllCommands(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> commands = GenerateRandomInts(n, 1, 4);
+
+    for (auto _ : state) {
+        Deque deque;
+        deque.Reserve(n);
+        for (int i = 0; i < n; i++) {
+            switch (commands[i]) {
+                case 1:
+                    deque.PushFront(i);
+                    break;
+                case 2:
+                    if (!deque.Empty()) {
+                        benchmark::DoNotOptimize(deque.PopFront());
+                    }
+                    break;
+                case 3:
+                    deque.PushBack(i);
+                    break;
+                default:
+                    if (!deque.Empty()) {
+                        benchmark::DoNotOptimize(deque.PopBack());
+                    }
+            }
+        }
+    }
+    ReportCounters(state, static_cast<int64_t>(n));
+}
+BENCHMARK(BM_DequeAllCommands)->Apply(ScaleArguments);
+
+
+// Политики буфера для сравнения: 0 - прежняя (сужение при заполнении 1/4
+// до 1/2), 1 - по умолчанию (сужение при заполнении 1/8), 2 - без сужения
+static CapacityPolicy GetPolicy(int64_t index) {
+    CapacityPolicy policy;
+    if (index == 0) {
+        policy.shrink_threshold = 0.25;
+    } else if (index == 2) {
+        policy.is_shrinking = false;
+    }
+
+    return policy;
+}
+
+
+// Аргументы (n, номер политики)
+static void PolicyArguments(benchmark::internal::Benchmark *b) {
+    for (int64_t n = benchmark_min_scale; n <= 10000; n *= 10) {
+        for (int64_t policy = 0; policy < 3; policy++) {
+            b->Args({n, policy});
+        }
+    }
+}
+
+
+// Вырожденный для динамического буфера случай: размер стека колеблется около
+// границы сужения буфера. reallocations - количество перевыделений буфера
+static void BM_StackOscillation(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const CapacityPolicy policy = GetPolicy(state.range(1));
+
+    int64_t reallocations = 0;
+    for (auto _ : state) {
+        Stack stack(policy);
+        int capacity = stack.Capacity();
+        reallocations = 0;
+
+        // Размер стека колеблется между 40 и 81: при прежней политике каждый
+        // цикл расширяет буфер до 160 элементов и сужает обратно до 80
+        for (int i = 0; i < 40; i++) {
+            stack.Push(i);
+        }
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < 41; j++) {
+                stack.Push(j);
+                reallocations += (stack.Capacity() != capacity);
+                capacity = stack.Capacity();
+            }
+            for (int j = 0; j < 41; j++) {
+                benchmark::DoNotOptimize(stack.Pop());
+                reallocations += (stack.Capacity() != capacity);
+                capacity = stack.Capacity();
+            }
+        }
+    }
+    ReportCounters(state, 82 * static_cast<int64_t>(n));
+    state.counters["reallocations"] = static_cast<double>(reallocations);
+}
+BENCHMARK(BM_StackOscillation)->Apply(PolicyArguments);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,155 @@
+// Дек на кольцевом буфере.
+//
+// Элементы лежат в непрерывном буфере, размер которого - степень двойки:
+// начало дека - позиция head, i-й элемент - позиция (head + i) & mask. Все
+// четыре операции меняют только head и size, поэтому выполняются за O(1)
+// без перекладывания элементов. Буфер расширяется в 2 раза при заполнении;
+// если заранее вызвать Reserve на максимальный размер, расширений не будет, и
+// каждая операция выполняется за O(1) в худшем случае.
+
+
+#ifndef HOMETASK_1_3_DEQUE_H
+#define HOMETASK_1_3_DEQUE_H
+
+
+#include <cassert>
+
+#include "dynamic_buffer.h"
+
+
+class Deque {
+private:
+    // Начальный размер буфера
+    static const int default_size = 16;
+
+    DynamicBuffer<int> buffer; // Выделенный буфер
+    int mask; // Размер буфера - 1
+    int head; // Позиция первого элемента
+    int size; // Количество элементов
+
+    // Политика буфера: размер меняется только через Reserve
+    static CapacityPolicy GetPolicy();
+
+    // Расширить буфер до new_size (степень двойки), сохранив порядок
+    void Resize(int new_size);
+
+public:
+    Deque();
+
+    bool Empty() const;
+
+    int Size() const;
+
+    // Выделить буфер не меньше size элементов
+    void Reserve(int size_);
+
+    void PushFront(int value);
+
+    void PushBack(int value);
+
+    int PopFront();
+
+    int PopBack();
+};
+
+
+// Время работы: O(1)
+inline CapacityPolicy Deque::GetPolicy() {
+    CapacityPolicy policy;
+    policy.min_capacity = default_size;
+    policy.is_shrinking = false;
+
+    return policy;
+}
+
+
+inline Deque::Deque() : buffer(GetPolicy()), mask(default_size - 1), head(0),
+                        size(0) {}
+
+
+// Время работы: O(new_size)
+inline void Deque::Resize(int new_size) {
+    const int old_size = mask + 1;
+    assert((new_size > old_size) && ((new_size & (new_size - 1)) == 0));
+
+    // Элементы [head, old_size) остаются на месте, а перенесенные через
+    // конец буфера элементы [0, head + size - old_size) переносятся за
+    // старый конец буфера
+    buffer.Reserve(new_size, old_size);
+    for (int i = 0; i < head + size - old_size; i++) {
+        buffer[old_size + i] = buffer[i];
+    }
+    mask = new_size - 1;
+}
+
+
+// Время работы: O(1)
+inline bool Deque::Empty() const {
+    return (size == 0);
+}
+
+
+// Время работы: O(1)
+inline int Deque::Size() const {
+    return size;
+}
+
+
+// Время работы: O(size_) (O(1), если буфер уже не меньше size_)
+inline void Deque::Reserve(int size_) {
+    int new_size = mask + 1;
+    while (new_size < size_) {
+        new_size *= 2;
+    }
+
+    if (new_size > mask + 1) {
+        Resize(new_size);
+    }
+}
+
+
+// Амортизированное время работы: O(1)
+inline void Deque::PushFront(int value) {
+    if (size == mask + 1) {
+        Resize(2 * (mask + 1));
+    }
+
+    head = (head - 1) & mask;
+    buffer[head] = value;
+    size++;
+}
+
+
+// Амортизированное время работы: O(1)
+inline void Deque::PushBack(int value) {
+    if (size == mask + 1) {
+        Resize(2 * (mask + 1));
+    }
+
+    buffer[(head + size) & mask] = value;
+    size++;
+}
+
+
+// Время работы: O(1)
+inline int Deque::PopFront() {
+    assert(!Empty());
+
+    const int result = buffer[head];
+    head = (head + 1) & mask;
+    size--;
+
+    return result;
+}
+
+
+// Время работы: O(1)
+inline int Deque::PopBack() {
+    assert(!Empty());
+
+    size--;
+    return buffer[(head + size) & mask];
+}
+
+
+#endif //HOMETASK_1_3_DEQUE_H
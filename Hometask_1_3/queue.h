@@ -0,0 +1,140 @@
+// Очередь, реализованная с помощью двух стеков на динамическом буфере.
+
+
+#ifndef HOMETASK_1_3_QUEUE_H
+#define HOMETASK_1_3_QUEUE_H
+
+
+#include <cassert>
+
+#include "dynamic_buffer.h"
+
+
+class Stack {
+private:
+    DynamicBuffer<int> buffer; // Выделенный буфер
+    int head; // Номер верхнего элемента
+
+public:
+    explicit Stack(const CapacityPolicy &policy = CapacityPolicy());
+
+    bool Empty() const;
+
+    int Size() const;
+
+    // Размер выделенного буфера
+    int Capacity() const;
+
+    // Выделить буфер не меньше size элементов
+    void Reserve(int size);
+
+    void Push(int value);
+
+    int Pop();
+};
+
+
+inline Stack::Stack(const CapacityPolicy &policy) : buffer(policy),
+                                                    head(-1) {}
+
+
+// Время работы: O(1)
+inline bool Stack::Empty() const {
+    return (head == -1);
+}
+
+
+// Время работы: O(1)
+inline int Stack::Size() const {
+    return (head + 1);
+}
+
+
+// Время работы: O(1)
+inline int Stack::Capacity() const {
+    return static_cast<int>(buffer.Capacity());
+}
+
+
+// Время работы: O(Size())
+inline void Stack::Reserve(int size) {
+    buffer.Reserve(size, Size());
+}
+
+
+// Амортизированное время работы: O(1)
+inline void Stack::Push(int value) {
+    // Расширяем буфер, если в нём закончилось место
+    buffer.PrepareForPush(Size());
+    buffer[++head] = value;
+}
+
+
+// Амортизированное время работы: O(1)
+inline int Stack::Pop() {
+    assert(!Empty());
+    int result = buffer[head--];
+
+    // Сужаем буфер, если в нём занято мало ячеек (см. CapacityPolicy)
+    buffer.ShrinkIfNeeded(Size());
+
+    return result;
+}
+
+
+class Queue {
+private:
+    Stack left_stack;
+    Stack right_stack;
+
+public:
+    explicit Queue(const CapacityPolicy &policy = CapacityPolicy())
+            : left_stack(policy), right_stack(policy) {}
+
+    bool Empty() const;
+
+    // Выделить буферы не меньше size элементов
+    void Reserve(int size);
+
+    void Push(int value);
+
+    int Pop();
+};
+
+
+// Время работы: O(1)
+inline bool Queue::Empty() const {
+    return (left_stack.Empty() && right_stack.Empty());
+}
+
+
+// Время работы: O(size)
+inline void Queue::Reserve(int size) {
+    left_stack.Reserve(size);
+    right_stack.Reserve(size);
+}
+
+
+// Амортизированное время работы: O(1)
+inline void Queue::Push(int value) {
+    left_stack.Push(value);
+}
+
+
+// Амортизированное время работы: O(1)
+inline int Queue::Pop() {
+    assert(!Empty());
+
+    // Если в правом стеке нет элементов,
+    // переложим все элементы из левого стека в правый
+    if (right_stack.Empty()) {
+        while (!left_stack.Empty()) {
+            right_stack.Push(left_stack.Pop());
+        }
+    }
+
+    return right_stack.Pop();
+}
+
+
+#endif //HOMETASK_1_3_QUEUE_H
@@ -0,0 +1,248 @@
+// Бенчмарки минимальной кучи (задача 2_3).
+
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "min_heap.h"
+
+
+using std::pair;
+using std::vector;
+
+
+// Расписание из n электричек, упорядоченное по времени прибытия
+static vector<pair<int, int>> GenerateSchedule(int n, int max_stay) {
+    vector<int> arrivals = GenerateRandomInts(n, 0, 1000000000 - max_stay);
+    const vector<int> stays = GenerateRandomInts(n, 0, max_stay,
+                                                 benchmark_seed + 1);
+    std::sort(arrivals.begin(), arrivals.end());
+
+    vector<pair<int, int>> schedule(n);
+    for (int i = 0; i < n; i++) {
+        schedule[i] = {arrivals[i], arrivals[i] + stays[i]};
+    }
+
+    return schedule;
+}
+
+
+// Цикл из main: подсчет минимального количества тупиков
+template<typename THeap = MinHeap<int>>
+static int CountDeadEnds(const vector<pair<int, int>> &schedule) {
+    THeap min_heap;
+    int max_trains = 0;
+
+    for (const auto &train : schedule) {
+        while (!min_heap.Empty() && (min_heap.Top() < train.first)) {
+            min_heap.Pop();
+        }
+        min_heap.Push(train.second);
+        max_trains = std::max(max_trains, min_heap.Size());
+    }
+
+    return max_trains;
+}
+
+
+// Случайное расписание: в куче в среднем немного электричек
+static void BM_DeadEndsRandom(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const auto schedule = GenerateSchedule(n, 1000000);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CountDeadEnds<>(schedule));
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_DeadEndsRandom)->Apply(ScaleArguments);
+
+
+// Все электрички стоят до конца: куча растет до n элементов
+static void BM_DeadEndsAllOverlap(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    auto schedule = GenerateSchedule(n, 0);
+    for (auto &train : schedule) {
+        train.second = 1000000000 - (train.first % 1000);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CountDeadEnds<>(schedule));
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_DeadEndsAllOverlap)->Apply(ScaleArguments);
+
+
+// Случайные Push, затем все Pop
+static void BM_HeapPushPopRandom(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        MinHeap<int> min_heap;
+        for (int value : values) {
+            min_heap.Push(value);
+        }
+        while (!min_heap.Empty()) {
+            benchmark::DoNotOptimize(min_heap.Pop());
+        }
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_HeapPushPopRandom)->Apply(ScaleArguments);
+
+
+// Вырожденный для SiftUp случай: каждый новый элемент поднимается в корень
+static void BM_HeapPushDescending(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateSortedInts(n, true);
+
+    for (auto _ : state) {
+        MinHeap<int> min_heap;
+        for (int value : values) {
+            min_heap.Push(value);
+        }
+        benchmark::DoNotOptimize(min_heap.Top());
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_HeapPushDescending)->Apply(ScaleArguments);
+
+
+// Построение кучи из массива за O(n)
+static void BM_HeapFromArray(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        vector<int> copy = values;
+        MinHeap<int> min_heap(copy.data(), n, false);
+        benchmark::DoNotOptimize(min_heap.Top());
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_HeapFromArray)->Apply(ScaleArguments);
+
+
+// Политики буфера для сравнения: 0 - прежняя (сужение при заполнении 1/4
+// до 1/2), 1 - по умолчанию (сужение при заполнении 1/8), 2 - без сужения
+static CapacityPolicy GetPolicy(int64_t index) {
+    CapacityPolicy policy;
+    if (index == 0) {
+        policy.shrink_threshold = 0.25;
+    } else if (index == 2) {
+        policy.is_shrinking = false;
+    }
+
+    return policy;
+}
+
+
+// Аргументы (n, номер политики)
+static void PolicyArguments(benchmark::internal::Benchmark *b) {
+    for (int64_t n = benchmark_min_scale; n <= GetMaxScale(); n *= 10) {
+        for (int64_t policy = 0; policy < 3; policy++) {
+            b->Args({n, policy});
+        }
+    }
+}
+
+
+// Волны расписания: в куче то много электричек, то мало, и буфер то
+// расширяется, то сужается. reallocations - количество перевыделений буфера
+static void BM_HeapWaves(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const CapacityPolicy policy = GetPolicy(state.range(1));
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+    // Размер кучи колеблется между 150 и 650 элементами
+    const int low = 150;
+    const int high = 650;
+
+    int64_t reallocations = 0;
+    for (auto _ : state) {
+        MinHeap<int> min_heap(std::less<int>(), policy);
+        int capacity = min_heap.Capacity();
+        reallocations = 0;
+
+        for (int i = 0; i < n; i++) {
+            min_heap.Push(values[i]);
+            if (min_heap.Size() == high) {
+                while (min_heap.Size() > low) {
+                    benchmark::DoNotOptimize(min_heap.Pop());
+                    reallocations += (min_heap.Capacity() != capacity);
+                    capacity = min_heap.Capacity();
+                }
+            }
+            reallocations += (min_heap.Capacity() != capacity);
+            capacity = min_heap.Capacity();
+        }
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+    state.counters["reallocations"] = static_cast<double>(reallocations);
+}
+BENCHMARK(BM_HeapWaves)->Apply(PolicyArguments);
+
+
+// Событие расписания: время отправления и номер тупика
+struct TrackEvent {
+    int time;
+    int track;
+};
+
+
+// Сравнение событий по времени, при равном времени - по номеру тупика
+struct CompareByTime {
+    bool operator()(const TrackEvent &first, const TrackEvent &second) const {
+        return (first.time < second.time) ||
+               ((first.time == second.time) && (first.track < second.track));
+    }
+};
+
+
+// Все электрички стоят до конца, куча из arity-ичных узлов
+template<int arity>
+static void BM_DeadEndsArity(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    auto schedule = GenerateSchedule(n, 0);
+    for (auto &train : schedule) {
+        train.second = 1000000000 - (train.first % 1000);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+                CountDeadEnds<MinHeap<int, std::less<int>, arity>>(schedule));
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK_TEMPLATE(BM_DeadEndsArity, 2)->Apply(ScaleArguments);
+BENCHMARK_TEMPLATE(BM_DeadEndsArity, 4)->Apply(ScaleArguments);
+BENCHMARK_TEMPLATE(BM_DeadEndsArity, 8)->Apply(ScaleArguments);
+
+
+// Случайные Push событий (время, тупик), затем все Pop: сравнение арностей
+template<int arity>
+static void BM_HeapArityPushPop(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<int> times = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        MinHeap<TrackEvent, CompareByTime, arity> min_heap;
+        for (int i = 0; i < n; i++) {
+            min_heap.Push({times[i], i});
+        }
+        while (!min_heap.Empty()) {
+            benchmark::DoNotOptimize(min_heap.Pop());
+        }
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+}
+BENCHMARK_TEMPLATE(BM_HeapArityPushPop, 2)->Apply(ScaleArguments);
+BENCHMARK_TEMPLATE(BM_HeapArityPushPop, 4)->Apply(ScaleArguments);
+BENCHMARK_TEMPLATE(BM_HeapArityPushPop, 8)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
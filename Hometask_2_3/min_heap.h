@@ -0,0 +1,212 @@
+// Минимальная d-арная куча на динамическом буфере.
+//
+// Тип элементов T, компаратор TCompare (функтор "меньше", как в BubbleSortT
+// из Lesson_2) и арность arity - параметры шаблона. У элемента с номером pos
+// дети имеют номера arity * pos + 1, ..., arity * pos + arity, поэтому при
+// большей арности куча ниже, а дети одного элемента лежат рядом в памяти:
+// SiftUp делает меньше шагов, а SiftDown сравнивает больше детей на шаге, но
+// читает их из одной-двух кэш-линий. Просеивание общее с IndexedMinHeap
+// (d_ary_heap.h).
+
+
+#ifndef HOMETASK_2_3_MIN_HEAP_H
+#define HOMETASK_2_3_MIN_HEAP_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+#include "d_ary_heap.h"
+#include "dynamic_buffer.h"
+
+
+template<typename T, typename TCompare = std::less<T>, int arity = 2>
+class MinHeap {
+private:
+    static_assert(arity >= 2, "MinHeap arity must be at least 2");
+
+    DynamicBuffer<T> heap; // Выделенный буфер
+    int last; // Номер последнего элемента кучи
+    TCompare compare; // Сравнение элементов: compare(a, b) - a меньше b
+
+    // Добавить элемент в конец кучи
+    void PushBack(const T &value);
+
+    // Извлечь элемент из корня кучи
+    T PopFront();
+
+    // Просеять элемент вверх
+    void SiftUp(int pos);
+
+    // Просеять элемент вниз
+    void SiftDown(int pos);
+
+public:
+    explicit MinHeap(const TCompare &compare_ = TCompare(),
+                     const CapacityPolicy &policy = CapacityPolicy());
+
+    // Конструктор от массива (при is_inplace куча становится владельцем arr,
+    // выделенного через new[])
+    MinHeap(T *arr, int arr_size, bool is_inplace,
+            const TCompare &compare_ = TCompare(),
+            const CapacityPolicy &policy = CapacityPolicy());
+
+    // Констурктор копирования
+    MinHeap(const MinHeap &) = delete;
+
+    // Конструктор перемещения
+    MinHeap(MinHeap &&) = delete;
+
+    // Оператор присваивания копированием
+    MinHeap &operator=(const MinHeap &) = delete;
+
+    // Оператор присваивания перемещением
+    MinHeap &operator=(MinHeap &&) = delete;
+
+    bool Empty() const;
+
+    const T &Top() const;
+
+    int Size() const;
+
+    // Размер выделенного буфера
+    int Capacity() const;
+
+    // Выделить буфер не меньше size элементов
+    void Reserve(int size);
+
+    // Добавить элемент в кучу
+    void Push(const T &value);
+
+    // Извлечь элемент из кучи
+    T Pop();
+};
+
+
+template<typename T, typename TCompare, int arity>
+MinHeap<T, TCompare, arity>::MinHeap(const TCompare &compare_,
+                                     const CapacityPolicy &policy)
+        : heap(policy), last(-1), compare(compare_) {}
+
+
+// Амортизированное время работы: O(arr_size)
+template<typename T, typename TCompare, int arity>
+MinHeap<T, TCompare, arity>::MinHeap(T *arr, int arr_size, bool is_inplace,
+                                     const TCompare &compare_,
+                                     const CapacityPolicy &policy)
+        : heap(is_inplace ? arr : new T[arr_size], arr_size, policy),
+          last(arr_size - 1), compare(compare_) {
+    if (!is_inplace) {
+        for (int i = 0; i < arr_size; i++) {
+            heap[i] = arr[i];
+        }
+    }
+
+    // Просеиваем вниз все элементы, у которых есть дети
+    for (int i = (arr_size - 2) / arity; i >= 0; i--) {
+        SiftDown(i);
+    }
+}
+
+
+// Амортизированное время работы: O(1)
+template<typename T, typename TCompare, int arity>
+void MinHeap<T, TCompare, arity>::PushBack(const T &value) {
+    // Расширяем буфер, если в нём закончилось место
+    heap.PrepareForPush(Size());
+    heap[++last] = value;
+}
+
+
+// Амортизированное время работы: O(1)
+template<typename T, typename TCompare, int arity>
+T MinHeap<T, TCompare, arity>::PopFront() {
+    T result = Top();
+    heap[0] = heap[last--];
+
+    // Сужаем буфер, если в нём занято мало ячеек (см. CapacityPolicy)
+    heap.ShrinkIfNeeded(Size());
+
+    return result;
+}
+
+
+// Время работы: O(log(n) / log(arity))
+template<typename T, typename TCompare, int arity>
+void MinHeap<T, TCompare, arity>::SiftUp(int pos) {
+    DArySiftUp<arity>(pos, [this](int first, int second) {
+        return compare(heap[first], heap[second]);
+    }, [this](int first, int second) {
+        std::swap(heap[first], heap[second]);
+    });
+}
+
+
+// Время работы: O(arity * log(n) / log(arity))
+template<typename T, typename TCompare, int arity>
+void MinHeap<T, TCompare, arity>::SiftDown(int pos) {
+    DArySiftDown<arity>(pos, Size(), [this](int first, int second) {
+        return compare(heap[first], heap[second]);
+    }, [this](int first, int second) {
+        std::swap(heap[first], heap[second]);
+    });
+}
+
+
+// Время работы: O(1)
+template<typename T, typename TCompare, int arity>
+bool MinHeap<T, TCompare, arity>::Empty() const {
+    return (last == -1);
+}
+
+
+// Время работы: O(1)
+template<typename T, typename TCompare, int arity>
+const T &MinHeap<T, TCompare, arity>::Top() const {
+    assert(!Empty());
+
+    return heap[0];
+}
+
+
+// Время работы: O(1)
+template<typename T, typename TCompare, int arity>
+int MinHeap<T, TCompare, arity>::Size() const {
+    return (last + 1);
+}
+
+
+// Время работы: O(1)
+template<typename T, typename TCompare, int arity>
+int MinHeap<T, TCompare, arity>::Capacity() const {
+    return static_cast<int>(heap.Capacity());
+}
+
+
+// Время работы: O(Size())
+template<typename T, typename TCompare, int arity>
+void MinHeap<T, TCompare, arity>::Reserve(int size) {
+    heap.Reserve(size, Size());
+}
+
+
+// Амортизированное время работы: O(log(n) / log(arity))
+template<typename T, typename TCompare, int arity>
+void MinHeap<T, TCompare, arity>::Push(const T &value) {
+    PushBack(value);
+    SiftUp(last);
+}
+
+
+// Амортизированное время работы: O(arity * log(n) / log(arity))
+template<typename T, typename TCompare, int arity>
+T MinHeap<T, TCompare, arity>::Pop() {
+    T result = PopFront();
+    SiftDown(0);
+
+    return result;
+}
+
+
+#endif //HOMETASK_2_3_MIN_HEAP_H
@@ -0,0 +1,57 @@
+// Бенчмарки сортировки слиянием с подсчетом инверсий (задача 3_3).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "merge_sort.h"
+
+
+using std::vector;
+
+
+// Сортировка копии values, копирование не входит в замер
+static void RunMergeSort(benchmark::State &state, const vector<int> &values) {
+    vector<int> copy(values.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        copy = values;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(MergeSortIterativeWithInvCount(
+                copy.data(), static_cast<int>(copy.size())));
+    }
+    ReportCounters(state, static_cast<int64_t>(values.size()));
+}
+
+
+static void BM_MergeSortRandom(benchmark::State &state) {
+    RunMergeSort(state, GenerateRandomInts(state.range(0), -1000000000,
+                                           1000000000));
+}
+BENCHMARK(BM_MergeSortRandom)->Apply(ScaleArguments);
+
+
+// Нет инверсий
+static void BM_MergeSortSorted(benchmark::State &state) {
+    RunMergeSort(state, GenerateSortedInts(state.range(0), false));
+}
+BENCHMARK(BM_MergeSortSorted)->Apply(ScaleArguments);
+
+
+// Максимальное количество инверсий: n * (n - 1) / 2
+static void BM_MergeSortReversed(benchmark::State &state) {
+    RunMergeSort(state, GenerateSortedInts(state.range(0), true));
+}
+BENCHMARK(BM_MergeSortReversed)->Apply(ScaleArguments);
+
+
+// Много одинаковых элементов
+static void BM_MergeSortFewUnique(benchmark::State &state) {
+    RunMergeSort(state, GenerateRandomInts(state.range(0), 0, 15));
+}
+BENCHMARK(BM_MergeSortFewUnique)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
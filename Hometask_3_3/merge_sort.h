@@ -0,0 +1,117 @@
+// Итеративная сортировка слиянием с подсчетом количества инверсий.
+//
+// Вспомогательный буфер размера массива выделяется один раз на всю
+// сортировку. Каждый проход сливает подмассивы из одного массива в другой
+// (массив и буфер попеременно меняются ролями), поэтому после слияния
+// ничего не копируется обратно. Отрезки по insertion_sort_size элементов
+// сначала сортируются вставками, что тоже считает инверсии: каждый сдвиг
+// элемента устраняет ровно одну инверсию.
+
+
+#ifndef HOMETASK_3_3_MERGE_SORT_H
+#define HOMETASK_3_3_MERGE_SORT_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+// Размер отрезков, сортируемых вставками
+const int insertion_sort_size = 16;
+
+
+// Время работы: O((right - left)^2)
+inline int64_t InsertionSortWithInvCount(int *array, int left, int right) {
+    int64_t n_inversions = 0;
+
+    for (int i = left + 1; i < right; i++) {
+        const int value = array[i];
+        int j = i;
+        // Равные элементы не переставляются: они не образуют инверсию
+        while ((j > left) && (array[j - 1] > value)) {
+            array[j] = array[j - 1];
+            j--;
+        }
+        array[j] = value;
+        n_inversions += i - j;
+    }
+
+    return n_inversions;
+}
+
+
+// Слить отсортированные source[left, mid) и source[mid, right) в
+// target[left, right)
+// Время работы: O(right - left)
+inline int64_t MergeWithInvCount(const int *source, int *target, int left,
+                                 int mid, int right) {
+    int64_t n_inversions = 0;
+    int l_it = left;
+    int r_it = mid;
+    int pos = left;
+
+    while (l_it < mid && r_it < right) {
+        if (source[l_it] <= source[r_it]) {
+            target[pos++] = source[l_it++];
+        } else {
+            target[pos++] = source[r_it++];
+            // Добавляем число инверсий текущего элемента из правого подмассива
+            // со всеми оставшимися элементами левого подмассива
+            n_inversions += (mid - l_it);
+        }
+    }
+
+    std::memcpy(target + pos, source + l_it, sizeof(int) * (mid - l_it));
+    pos += mid - l_it;
+    std::memcpy(target + pos, source + r_it, sizeof(int) * (right - r_it));
+    assert(pos + right - r_it == right);
+
+    return n_inversions;
+}
+
+
+// Время работы: O(size * log(size))
+inline int64_t MergeSortIterativeWithInvCount(int *array, int size) {
+    int64_t n_inversions = 0;
+
+    for (int j = 0; j < size; j += insertion_sort_size) {
+        n_inversions += InsertionSortWithInvCount(
+                array, j, std::min(j + insertion_sort_size, size));
+    }
+    if (size <= insertion_sort_size) {
+        return n_inversions;
+    }
+
+    std::vector<int> buffer(size);
+    int *source = array;
+    int *target = buffer.data();
+
+    // i - текущий размер подмассивов
+    // j - левая граница двух объединяемых подмассивов
+    for (int i = insertion_sort_size; i < size; i *= 2) {
+        int j = 0;
+        for (; j < size - i; j += 2 * i) {
+            const int right = (j + 2 * i <= size) ? j + 2 * i : size;
+            n_inversions += MergeWithInvCount(source, target, j, j + i, right);
+        }
+        // Подмассив без пары переносится в target без изменений
+        if (j < size) {
+            std::memcpy(target + j, source + j, sizeof(int) * (size - j));
+        }
+
+        std::swap(source, target);
+    }
+
+    // Отсортированные элементы - в source
+    if (source != array) {
+        std::memcpy(array, source, sizeof(int) * size);
+    }
+
+    return n_inversions;
+}
+
+
+#endif //HOMETASK_3_3_MERGE_SORT_H
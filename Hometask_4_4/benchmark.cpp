@@ -0,0 +1,76 @@
+// Бенчмарки поиска k-й порядковой статистики (задача 4_4).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "order_statistics.h"
+
+
+using std::vector;
+
+
+// Поиск медианы в копии values, копирование не входит в замер
+static void RunOrderStat(benchmark::State &state, const vector<int> &values) {
+    const int size = static_cast<int>(values.size());
+    vector<int> copy(values.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        copy = values;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(FindOrderStatIterative(copy.data(), size,
+                                                        size / 2));
+    }
+    ReportCounters(state, size);
+}
+
+
+static void BM_OrderStatRandom(benchmark::State &state) {
+    RunOrderStat(state, GenerateRandomInts(state.range(0), 0, 1000000000));
+}
+BENCHMARK(BM_OrderStatRandom)->Apply(ScaleArguments);
+
+
+static void BM_OrderStatSorted(benchmark::State &state) {
+    RunOrderStat(state, GenerateSortedInts(state.range(0), false));
+}
+BENCHMARK(BM_OrderStatSorted)->Apply(ScaleArguments);
+
+
+static void BM_OrderStatReversed(benchmark::State &state) {
+    RunOrderStat(state, GenerateSortedInts(state.range(0), true));
+}
+BENCHMARK(BM_OrderStatReversed)->Apply(ScaleArguments);
+
+
+// Вырожденный для Partition случай: элементы, равные опорному, всегда
+// попадают в одну часть, и время работы становится квадратичным
+static void BM_OrderStatFewUnique(benchmark::State &state) {
+    RunOrderStat(state, GenerateRandomInts(state.range(0), 0, 3));
+}
+BENCHMARK(BM_OrderStatFewUnique)->Apply(QuadraticScaleArguments);
+
+
+// std::nth_element для сравнения
+static void BM_OrderStatDefault(benchmark::State &state) {
+    const vector<int> values = GenerateRandomInts(state.range(0), 0,
+                                                  1000000000);
+    const int size = static_cast<int>(values.size());
+    vector<int> copy(values.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        copy = values;
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(FindOrderStatDefault(copy.data(), size,
+                                                      size / 2));
+    }
+    ReportCounters(state, size);
+}
+BENCHMARK(BM_OrderStatDefault)->Apply(ScaleArguments);
+
+
+BENCHMARK_MAIN();
@@ -17,153 +17,22 @@
 // Потребляемая память: O(n)
 
 
-#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <random>
 #include <vector>
 
+#include "fast_input.h"
+#include "order_statistics.h"
+
 
-using std::cin;
 using std::cout;
 using std::endl;
 using std::pow;
-using std::swap;
 using std::vector;
 
 
-std::random_device rd;
-std::mt19937 generator(rd());
-
-
-int GetRandomArrayIndex(int size) {
-    // Возвращает случайное число из диапазона: [0; size)
-    std::uniform_int_distribution<> dis(0, size - 1);
-
-    return dis(generator);
-}
-
-
-// Время работы: O(right - left)
-int PartitionForward(int *array, int left, int right) {
-    // Случайно выбирает опорный элемент, ставит его на правильную позицию в
-    // отсортированном по неубыванию массиве
-    // Проход двумя итераторами от начала массива к концу
-    assert(left < right);
-
-    array = array + left;
-    int size = right - left;
-    int pivot = GetRandomArrayIndex(size);
-    swap(array[pivot], array[size - 1]);
-
-    int i = 0, j = 0;
-    // В массиве слева направо лежат:
-    // - элементы не больше опорного: [0; i)
-    // - элементы строго больше опорного: [i; j)
-    // - нерассмотренные элементы: [j; size - 1)
-    // - опорный элемент на позиции (size - 1)
-
-    while (j < size - 1) {
-        if (array[j] <= array[size - 1]) {
-            swap(array[i], array[j]);
-            i++;
-        }
-        j++;
-    }
-    swap(array[i], array[size - 1]);
-
-    return left + i;
-}
-
-
-// Время работы: O(right - left)
-int PartitionBackward(int *array, int left, int right) {
-    // Случайно выбирает опорный элемент, ставит его на правильную позицию в
-    // отсортированном по неубыванию массиве
-    // Проход двумя итераторами от конца массива к началу
-    assert(left < right);
-
-    array = array + left;
-    int size = right - left;
-    int pivot = GetRandomArrayIndex(size);
-    swap(array[pivot], array[0]);
-
-    int i = size - 1, j = size - 1;
-    // В массиве слева направо лежат:
-    // - опорный элемент на позиции 0
-    // - нерассмотренные элементы: [1; j]
-    // - элементы не больше опорного: [j + 1; i]
-    // - элементы строго больше опорного: [i + 1; size - 1]
-
-    while (j >= 1) {
-        if (array[j] > array[0]) {
-            swap(array[i], array[j]);
-            i--;
-        }
-        j--;
-    }
-    swap(array[i], array[0]);
-
-    return left + i;
-}
-
-
-// Среднее время работы: O(size)
-int FindOrderStatRecursive(int *array, int size, int k) {
-    assert(0 <= k && k < size);
-
-    int pivot = PartitionBackward(array, 0, size);
-    assert(0 <= pivot && pivot < size);
-
-    int kth_stat = 0;
-    if (pivot == k) {
-        kth_stat = array[pivot];
-    } else if (k < pivot) {
-        // Ищем в левой половине: [0; pivot)
-        kth_stat = FindOrderStatRecursive(array, pivot, k);
-    } else {
-        // Ищем в правой половине: [pivot + 1; size)
-        int bias = pivot + 1;
-        kth_stat = FindOrderStatRecursive(array + bias, size - bias, k - bias);
-    }
-
-    return kth_stat;
-}
-
-
-// Среднее время работы: O(size)
-int FindOrderStatIterative(int *array, int size, int k) {
-    assert(0 <= k && k < size);
-
-    int left = 0;
-    int right = size;
-
-    while (true) {
-        int pivot = PartitionBackward(array, left, right);
-        assert(left <= pivot && pivot < right);
-
-        if (pivot == k) {
-            return array[pivot];
-        } else if (k < pivot) {
-            // Ищем в левой половине: [left; pivot)
-            right = pivot;
-        } else {
-            // Ищем в правой половине: [pivot + 1; right)
-            left = pivot + 1;
-        }
-    }
-}
-
-
-int FindOrderStatDefault(int *array, int size, int k) {
-    assert(0 <= k && k < size);
-    std::nth_element(array, array + k, array + size);
-
-    return array[k];
-}
-
-
 void Test() {
     const int SIZES[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 20, 50, 100, 200};
     const int N_ITER = pow(10, 4);
@@ -200,6 +69,10 @@ void Test() {
             int res2 = FindOrderStatIterative(values2.data(), SIZE, k);
             assert(res0 == res1);
             assert(res0 == res2);
+            // При NDEBUG assert пуст, и результаты больше нигде не используются
+            (void) res0;
+            (void) res1;
+            (void) res2;
         }
         cout << " - finished" << endl;
     }
@@ -209,14 +82,17 @@ void Test() {
 int main() {
 //    Test();
 
+    FastInput input;
     int n = 0;
     int k = 0;
-    cin >> n >> k;
+    input.ReadInt(n);
+    input.ReadInt(k);
 
     int value = 0;
     vector<int> values = {};
+    values.reserve(n);
     for (int i = 0; i < n; i++) {
-        cin >> value;
+        input.ReadInt(value);
         values.push_back(value);
     }
 
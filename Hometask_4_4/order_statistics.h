@@ -0,0 +1,144 @@
+// Поиск k-й порядковой статистики с помощью Partition.
+
+
+#ifndef HOMETASK_4_4_ORDER_STATISTICS_H
+#define HOMETASK_4_4_ORDER_STATISTICS_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <random>
+
+
+static std::random_device rd;
+static std::mt19937 generator(rd());
+
+
+inline int GetRandomArrayIndex(int size) {
+    // Возвращает случайное число из диапазона: [0; size)
+    std::uniform_int_distribution<> dis(0, size - 1);
+
+    return dis(generator);
+}
+
+
+// Время работы: O(right - left)
+inline int PartitionForward(int *array, int left, int right) {
+    // Случайно выбирает опорный элемент, ставит его на правильную позицию в
+    // отсортированном по неубыванию массиве
+    // Проход двумя итераторами от начала массива к концу
+    assert(left < right);
+
+    array = array + left;
+    int size = right - left;
+    int pivot = GetRandomArrayIndex(size);
+    std::swap(array[pivot], array[size - 1]);
+
+    int i = 0, j = 0;
+    // В массиве слева направо лежат:
+    // - элементы не больше опорного: [0; i)
+    // - элементы строго больше опорного: [i; j)
+    // - нерассмотренные элементы: [j; size - 1)
+    // - опорный элемент на позиции (size - 1)
+
+    while (j < size - 1) {
+        if (array[j] <= array[size - 1]) {
+            std::swap(array[i], array[j]);
+            i++;
+        }
+        j++;
+    }
+    std::swap(array[i], array[size - 1]);
+
+    return left + i;
+}
+
+
+// Время работы: O(right - left)
+inline int PartitionBackward(int *array, int left, int right) {
+    // Случайно выбирает опорный элемент, ставит его на правильную позицию в
+    // отсортированном по неубыванию массиве
+    // Проход двумя итераторами от конца массива к началу
+    assert(left < right);
+
+    array = array + left;
+    int size = right - left;
+    int pivot = GetRandomArrayIndex(size);
+    std::swap(array[pivot], array[0]);
+
+    int i = size - 1, j = size - 1;
+    // В массиве слева направо лежат:
+    // - опорный элемент на позиции 0
+    // - нерассмотренные элементы: [1; j]
+    // - элементы не больше опорного: [j + 1; i]
+    // - элементы строго больше опорного: [i + 1; size - 1]
+
+    while (j >= 1) {
+        if (array[j] > array[0]) {
+            std::swap(array[i], array[j]);
+            i--;
+        }
+        j--;
+    }
+    std::swap(array[i], array[0]);
+
+    return left + i;
+}
+
+
+// Среднее время работы: O(size)
+inline int FindOrderStatRecursive(int *array, int size, int k) {
+    assert(0 <= k && k < size);
+
+    int pivot = PartitionBackward(array, 0, size);
+    assert(0 <= pivot && pivot < size);
+
+    int kth_stat = 0;
+    if (pivot == k) {
+        kth_stat = array[pivot];
+    } else if (k < pivot) {
+        // Ищем в левой половине: [0; pivot)
+        kth_stat = FindOrderStatRecursive(array, pivot, k);
+    } else {
+        // Ищем в правой половине: [pivot + 1; size)
+        int bias = pivot + 1;
+        kth_stat = FindOrderStatRecursive(array + bias, size - bias, k - bias);
+    }
+
+    return kth_stat;
+}
+
+
+// Среднее время работы: O(size)
+inline int FindOrderStatIterative(int *array, int size, int k) {
+    assert(0 <= k && k < size);
+
+    int left = 0;
+    int right = size;
+
+    while (true) {
+        int pivot = PartitionBackward(array, left, right);
+        assert(left <= pivot && pivot < right);
+
+        if (pivot == k) {
+            return array[pivot];
+        } else if (k < pivot) {
+            // Ищем в левой половине: [left; pivot)
+            right = pivot;
+        } else {
+            // Ищем в правой половине: [pivot + 1; right)
+            left = pivot + 1;
+        }
+    }
+}
+
+
+inline int FindOrderStatDefault(int *array, int size, int k) {
+    assert(0 <= k && k < size);
+    std::nth_element(array, array + k, array + size);
+
+    return array[k];
+}
+
+
+#endif //HOMETASK_4_4_ORDER_STATISTICS_H
@@ -0,0 +1,39 @@
+// Бенчмарки бинарного дерева поиска (задача 6_1).
+
+
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "tree.h"
+
+
+using std::vector;
+
+
+// Построение и удаление дерева из values
+static void RunTreeAdd(benchmark::State &state, const vector<int> &values) {
+    for (auto _ : state) {
+        Tree tree;
+        for (int value : values) {
+            tree.Add(value);
+        }
+    }
+    ReportCounters(state, static_cast<int64_t>(values.size()));
+}
+
+
+static void BM_TreeAddRandom(benchmark::State &state) {
+    RunTreeAdd(state, GenerateRandomInts(state.range(0), -1000000000,
+                                         1000000000));
+}
+BENCHMARK(BM_TreeAddRandom)->Apply(ScaleArguments);
+
+
+// Вырожденный случай: дерево превращается в список
+static void BM_TreeAddSorted(benchmark::State &state) {
+    RunTreeAdd(state, GenerateSortedInts(state.range(0), false));
+}
+BENCHMARK(BM_TreeAddSorted)->Apply(QuadraticScaleArguments);
+
+
+BENCHMARK_MAIN();
@@ -0,0 +1,113 @@
+// Бинарное дерево поиска с наивным порядком вставки.
+//
+// Узлы выделяются из пула (NodePool): они лежат в памяти блоками в порядке
+// добавления, а при разрушении дерева пул освобождает блоки целиком, без
+// обхода дерева и удаления каждого узла.
+
+
+#ifndef HOMETASK_6_1_TREE_H
+#define HOMETASK_6_1_TREE_H
+
+
+#include <iostream>
+#include <stack>
+
+#include "node_pool.h"
+
+
+struct TreeNode {
+    int value;
+    TreeNode *left;
+    TreeNode *right;
+
+    explicit TreeNode(int _value) : value(_value), left(nullptr),
+                                    right(nullptr) {}
+};
+
+
+class Tree {
+private:
+    NodePool<TreeNode> pool;
+    TreeNode *root;
+
+    static void PreOrderTraversalRecursive(TreeNode *node);
+
+    static void PreOrderTraversalIterative(TreeNode *node);
+
+public:
+    Tree() : root(nullptr) {}
+
+    void Print() const;
+
+    void Add(int value);
+};
+
+
+// Время работы: O(n)
+inline void Tree::Print() const {
+//    PreOrderTraversalRecursive(root);
+    PreOrderTraversalIterative(root);
+}
+
+
+// Время работы: O(n)
+inline void Tree::PreOrderTraversalRecursive(TreeNode *node) {
+    if (!node) return;
+
+    std::cout << node->value << " ";
+    PreOrderTraversalRecursive(node->left);
+    PreOrderTraversalRecursive(node->right);
+}
+
+
+// Время работы: O(n)
+inline void Tree::PreOrderTraversalIterative(TreeNode *node) {
+    if (!node) return;
+
+    std::stack<TreeNode *> node_stack;
+    node_stack.push(node);
+
+    while (!node_stack.empty()) {
+        node = node_stack.top();
+        node_stack.pop();
+        std::cout << node->value << " ";
+
+        if (node->right)
+            node_stack.push(node->right);
+
+        if (node->left)
+            node_stack.push(node->left);
+    }
+}
+
+
+// Среднее время работы: O(log(n))
+inline void Tree::Add(int value) {
+    if (!root) {
+        root = pool.New(value);
+
+        return;
+    }
+
+    TreeNode *current = root;
+    while (current) {
+        if (value >= current->value) {
+            if (current->right) {
+                current = current->right;
+            } else {
+                current->right = pool.New(value);
+                break;
+            }
+        } else {
+            if (current->left) {
+                current = current->left;
+            } else {
+                current->left = pool.New(value);
+                break;
+            }
+        }
+    }
+}
+
+
+#endif //HOMETASK_6_1_TREE_H
@@ -0,0 +1,376 @@
+// Бенчмарки множества строк на хэш-таблице (задача 8_1).
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "filtered_hash_table.h"
+#include "hash_table.h"
+#include "hash_table_snapshot.h"
+#include "sharded_hash_table.h"
+
+
+using std::chrono::duration;
+using std::chrono::steady_clock;
+using std::lock_guard;
+using std::mutex;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+
+// Параметры таблицы из main
+const size_t initial_size = 8;
+const int random_value = 5;
+
+
+// Добавление n случайных строк
+static void BM_HashTableAdd(benchmark::State &state) {
+    const vector<string> keys = GenerateRandomStrings(state.range(0), 5, 20);
+
+    for (auto _ : state) {
+        HashTable table(initial_size, random_value);
+        for (const string &key : keys) {
+            benchmark::DoNotOptimize(table.Add(key));
+        }
+    }
+    ReportCounters(state, state.range(0));
+}
+BENCHMARK(BM_HashTableAdd)->Apply(ScaleArguments);
+
+
+// Поиск n строк, половина из которых есть в таблице
+static void BM_HashTableHas(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+    const vector<string> absent = GenerateRandomStrings(n, 5, 20, 'z',
+                                                        benchmark_seed + 1);
+
+    HashTable table(initial_size, random_value);
+    for (const string &key : keys) {
+        table.Add(key);
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; i++) {
+            benchmark::DoNotOptimize(table.Has((i % 2) ? keys[i] : absent[i]));
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_HashTableHas)->Apply(ScaleArguments);
+
+
+// Поиск n строк, из которых в таблице только каждая десятая
+template<typename TTable>
+static void HasMostlyAbsent(benchmark::State &state, TTable &table) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+    const vector<string> absent = GenerateRandomStrings(n, 5, 20, 'z',
+                                                        benchmark_seed + 1);
+
+    for (const string &key : keys) {
+        table.Add(key);
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; i++) {
+            benchmark::DoNotOptimize(
+                    table.Has((i % 10 == 0) ? keys[i] : absent[i]));
+        }
+    }
+    ReportCounters(state, n);
+}
+
+
+static void BM_HashTableHasAbsent(benchmark::State &state) {
+    HashTable table(initial_size, random_value);
+    HasMostlyAbsent(state, table);
+}
+BENCHMARK(BM_HashTableHasAbsent)->Apply(ScaleArguments);
+
+
+// То же с фильтром Блума. negative_rate - доля запросов, на которые ответил
+// фильтр, fp_rate - доля отсутствующих строк, пропущенных фильтром
+static void BM_FilteredHashTableHasAbsent(benchmark::State &state) {
+    FilteredHashTable table(initial_size, random_value);
+    HasMostlyAbsent(state, table);
+    state.counters["negative_rate"] = table.GetStats().GetNegativeRate();
+    state.counters["fp_rate"] = table.GetStats().GetFalsePositiveRate();
+}
+BENCHMARK(BM_FilteredHashTableHasAbsent)->Apply(ScaleArguments);
+
+
+// Поток добавлений и удалений: в таблице одновременно не больше 1000 строк,
+// но удаленные ячейки накапливаются. capacity - итоговый размер таблицы
+static void BM_HashTableChurn(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+    const int window = 1000;
+
+    size_t capacity = 0;
+    for (auto _ : state) {
+        HashTable table(initial_size, random_value);
+        for (int i = 0; i < n; i++) {
+            benchmark::DoNotOptimize(table.Add(keys[i]));
+            if (i >= window) {
+                benchmark::DoNotOptimize(table.Remove(keys[i - window]));
+            }
+        }
+        capacity = table.Capacity();
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+    state.counters["capacity"] = static_cast<double>(capacity);
+}
+BENCHMARK(BM_HashTableChurn)->Apply(ScaleArguments);
+
+
+// Добавление n строк, удаление всех, кроме 10, и поиск оставшихся: таблица
+// уменьшается по мере удаления
+static void BM_HashTableDrain(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+    const int n_left = 10;
+
+    size_t capacity = 0;
+    for (auto _ : state) {
+        HashTable table(initial_size, random_value);
+        for (const string &key : keys) {
+            benchmark::DoNotOptimize(table.Add(key));
+        }
+        for (int i = n_left; i < n; i++) {
+            benchmark::DoNotOptimize(table.Remove(keys[i]));
+        }
+        for (int i = 0; i < n_left; i++) {
+            benchmark::DoNotOptimize(table.Has(keys[i]));
+        }
+        capacity = table.Capacity();
+    }
+    ReportCounters(state, 2 * static_cast<int64_t>(n));
+    state.counters["capacity"] = static_cast<double>(capacity);
+}
+BENCHMARK(BM_HashTableDrain)->Apply(ScaleArguments);
+
+
+// Аргументы (n, is_incremental) для сравнения режимов перехэширования
+static void IncrementalArguments(benchmark::internal::Benchmark *b) {
+    for (int64_t n = benchmark_min_scale; n <= GetMaxScale(); n *= 10) {
+        b->Args({n, 0});
+        b->Args({n, 1});
+    }
+}
+
+
+// Задержка отдельных добавлений: при перехэшировании сразу одно добавление
+// переносит всю таблицу, при постепенном - не больше migration_step ячеек.
+// p99_ns и max_ns - 99-й процентиль и максимум времени одного добавления
+static void BM_HashTableAddLatency(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool is_incremental = state.range(1) != 0;
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+
+    vector<double> latencies(n);
+    double p99 = 0;
+    double max = 0;
+    for (auto _ : state) {
+        HashTable table(initial_size, random_value, is_incremental);
+        for (int i = 0; i < n; i++) {
+            const steady_clock::time_point start = steady_clock::now();
+            benchmark::DoNotOptimize(table.Add(keys[i]));
+            latencies[i] = duration<double, std::nano>(steady_clock::now() -
+                                                       start).count();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        p99 = std::max(p99, latencies[n - 1 - n / 100]);
+        max = std::max(max, latencies[n - 1]);
+    }
+    ReportCounters(state, n);
+    state.counters["p99_ns"] = p99;
+    state.counters["max_ns"] = max;
+}
+BENCHMARK(BM_HashTableAddLatency)->Apply(IncrementalArguments);
+
+
+// Файл снимка для бенчмарка снимков (в текущей директории)
+const char snapshot_path[] = "Hometask_8_1_benchmark.snapshot";
+
+
+// Открытие снимка таблицы из n строк и поиск n строк, половина из которых
+// есть в снимке. Сравнивается с BM_HashTableAdd - восстановлением таблицы
+// добавлением всех строк
+static void BM_HashTableSnapshotOpen(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<string> keys = GenerateRandomStrings(n, 5, 20);
+    const vector<string> absent = GenerateRandomStrings(n, 5, 20, 'z',
+                                                        benchmark_seed + 1);
+
+    {
+        HashTable table(initial_size, random_value);
+        for (const string &key : keys) {
+            table.Add(key);
+        }
+        HashTableSnapshot::Save(table, snapshot_path);
+    }
+
+    for (auto _ : state) {
+        HashTableSnapshot snapshot(snapshot_path);
+        for (int i = 0; i < n; i++) {
+            benchmark::DoNotOptimize(
+                    snapshot.Has((i % 2) ? keys[i] : absent[i]));
+        }
+    }
+    std::remove(snapshot_path);
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_HashTableSnapshotOpen)->Apply(ScaleArguments);
+
+
+// Строки с одинаковым многочленным хэшем: "ba" и "af" имеют равные хэши
+// при random_value = 5 (98 * 5 + 97 = 97 * 5 + 102), поэтому любые их
+// конкатенации одной длины тоже совпадают по хэшу
+static vector<string> GenerateCollidingStrings(int n) {
+    vector<string> keys(n);
+    for (int i = 0; i < n; i++) {
+        for (int bit = 0; bit < 20; bit++) {
+            keys[i] += ((i >> bit) & 1) ? "ba" : "af";
+        }
+    }
+
+    return keys;
+}
+
+
+// Вырожденный случай: все строки попадают в одну цепочку проб
+static void BM_HashTableCollisions(benchmark::State &state) {
+    const vector<string> keys = GenerateCollidingStrings(state.range(0));
+
+    for (auto _ : state) {
+        HashTable table(initial_size, random_value);
+        for (const string &key : keys) {
+            benchmark::DoNotOptimize(table.Add(key));
+        }
+    }
+    ReportCounters(state, state.range(0));
+}
+BENCHMARK(BM_HashTableCollisions)->Apply(QuadraticScaleArguments);
+
+
+// Количество шардов и размер пакета в многопоточных бенчмарках
+const size_t n_shards = 64;
+const size_t batch_size = 256;
+// Количество различных ключей в многопоточных бенчмарках
+const int n_keys = 100000;
+
+// Общие для всех потоков таблицы многопоточных бенчмарков
+static unique_ptr<ShardedHashTable> sharded_table;
+static unique_ptr<HashTable> locked_table;
+static mutex locked_table_mutex;
+
+
+// Команды потока thread_index: добавления, удаления и поиски ключей из общего
+// набора, поэтому потоки работают с одними и теми же шардами
+static vector<ShardedHashTable::Command> GenerateCommands(int n,
+                                                          int thread_index) {
+    const char types[] = {'+', '-', '?', '?'};
+    const vector<string> keys = GenerateRandomStrings(n_keys, 5, 20);
+    const vector<int> choices = GenerateRandomInts(2 * n, 0, n_keys - 1,
+                                                   benchmark_seed +
+                                                   thread_index);
+
+    vector<ShardedHashTable::Command> commands(n);
+    for (int i = 0; i < n; i++) {
+        commands[i].type = types[choices[2 * i] % 4];
+        commands[i].key = keys[choices[2 * i + 1]];
+    }
+
+    return commands;
+}
+
+
+static void SetupShardedTable(const benchmark::State &) {
+    sharded_table.reset(new ShardedHashTable(n_shards, initial_size,
+                                             random_value));
+}
+
+
+static void TeardownShardedTable(const benchmark::State &) {
+    sharded_table.reset();
+}
+
+
+// Пакеты команд из нескольких потоков в шардированную таблицу
+static void BM_ShardedHashTableBatch(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<ShardedHashTable::Command> commands =
+            GenerateCommands(n, state.thread_index());
+
+    vector<ShardedHashTable::Command> batch;
+    vector<bool> results;
+    for (auto _ : state) {
+        for (size_t begin = 0; begin < commands.size(); begin += batch_size) {
+            const size_t end = std::min(begin + batch_size, commands.size());
+            batch.assign(commands.begin() + begin, commands.begin() + end);
+            sharded_table->Execute(batch, results);
+            benchmark::DoNotOptimize(results);
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_ShardedHashTableBatch)
+        ->Apply(ScaleArguments)
+        ->Apply(ThreadArguments)
+        ->Setup(SetupShardedTable)
+        ->Teardown(TeardownShardedTable)
+        ->UseRealTime();
+
+
+static void SetupLockedTable(const benchmark::State &) {
+    locked_table.reset(new HashTable(initial_size, random_value));
+}
+
+
+static void TeardownLockedTable(const benchmark::State &) {
+    locked_table.reset();
+}
+
+
+// Для сравнения: одна таблица под глобальной блокировкой
+static void BM_GlobalMutexHashTable(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const vector<ShardedHashTable::Command> commands =
+            GenerateCommands(n, state.thread_index());
+
+    for (auto _ : state) {
+        for (const ShardedHashTable::Command &command : commands) {
+            lock_guard<mutex> guard(locked_table_mutex);
+            switch (command.type) {
+                case '+':
+                    benchmark::DoNotOptimize(locked_table->Add(command.key));
+                    break;
+                case '-':
+                    benchmark::DoNotOptimize(
+                            locked_table->Remove(command.key));
+                    break;
+                default:
+                    benchmark::DoNotOptimize(locked_table->Has(command.key));
+            }
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_GlobalMutexHashTable)
+        ->Apply(ScaleArguments)
+        ->Apply(ThreadArguments)
+        ->Setup(SetupLockedTable)
+        ->Teardown(TeardownLockedTable)
+        ->UseRealTime();
+
+
+BENCHMARK_MAIN();
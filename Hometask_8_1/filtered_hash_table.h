@@ -0,0 +1,243 @@
+// Множество строк на хэш-таблице с фильтром Блума перед ней.
+//
+// Фильтр (CountingBloomFilter) хранит хэши всех ключей таблицы. Если фильтр
+// отвечает, что ключа нет, то Has и Remove возвращают false, не обращаясь к
+// таблице: проверка читает одну кэш-линию фильтра вместо цепочки проб и
+// сравнения строк. Это выгодно, когда большинство запросов - к отсутствующим
+// ключам. Когда ключей становится больше, чем рассчитан фильтр, фильтр
+// перестраивается в 2 раза большим по ключам из таблицы.
+//
+// Хэш для фильтра вычисляется по ключу отдельно от хэша таблицы: многочлен с
+// маленьким основанием дает много совпадающих хэшей у разных строк, и фильтр
+// на таком хэше пропускал бы каждую строку с совпавшим хэшем. Отдельный хэш
+// (GetStringHash) обрабатывает строку по 8 символов и не обращается к памяти
+// таблицы.
+//
+// Статистика фильтра: сколько проверок (Has и Remove) фильтр отсек сразу и
+// сколько раз он ошибся, т.е. пропустил к таблице отсутствующий ключ.
+
+
+#ifndef HOMETASK_8_1_FILTERED_HASH_TABLE_H
+#define HOMETASK_8_1_FILTERED_HASH_TABLE_H
+
+
+#include <cassert>
+#include <string>
+#include <utility>
+
+#include "counting_bloom_filter.h"
+#include "hash_table.h"
+#include "string_hash.h"
+
+
+// Статистика фильтра
+struct FilterStats {
+    // Количество проверок ключей фильтром
+    size_t queries = 0;
+    // Количество проверок, на которые фильтр ответил "ключа нет"
+    size_t negatives = 0;
+    // Количество отсутствующих ключей, пропущенных фильтром к таблице
+    size_t false_positives = 0;
+
+    // Доля проверок, завершенных фильтром
+    double GetNegativeRate() const;
+
+    // Доля отсутствующих ключей, пропущенных фильтром
+    double GetFalsePositiveRate() const;
+};
+
+
+class FilteredHashTable {
+private:
+    HashTable table;
+    CountingBloomFilter filter;
+    FilterStats stats;
+
+    // Проверить ключ фильтром и обновить статистику, false - ключа точно нет
+    bool MayContain(size_t hash);
+
+    // Учесть ответ таблицы на проверку, пропущенную фильтром
+    void CountResult(bool is_found);
+
+    // Перестроить фильтр, если ключей больше, чем он рассчитан
+    void GrowFilter();
+
+public:
+    FilteredHashTable(size_t initial_size, int random_value,
+                      bool is_incremental = false);
+
+    // Констурктор копирования
+    FilteredHashTable(const FilteredHashTable &) = delete;
+
+    // Конструктор перемещения
+    FilteredHashTable(FilteredHashTable &&) = delete;
+
+    // Оператор присваивания копированием
+    FilteredHashTable &operator=(const FilteredHashTable &) = delete;
+
+    // Оператор присваивания перемещением
+    FilteredHashTable &operator=(FilteredHashTable &&) = delete;
+
+    bool Has(const std::string &key);
+
+    bool Add(const std::string &key);
+
+    bool Remove(const std::string &key);
+
+    size_t GetBaseHash(const std::string &key) const;
+
+    // Операции с уже вычисленным хэшем hash = GetBaseHash(key)
+    bool Has(const std::string &key, size_t hash);
+
+    bool Add(const std::string &key, size_t hash);
+
+    bool Remove(const std::string &key, size_t hash);
+
+    // Предвыборка в кэш группы ячеек таблицы для хэша hash (перед пакетом
+    // операций). Блок фильтра зависит от другого хэша и читается при проверке
+    void Prefetch(size_t hash) const;
+
+    // Количество ключей в множестве
+    size_t Size() const;
+
+    const FilterStats &GetStats() const;
+};
+
+
+// Время работы: O(1)
+inline double FilterStats::GetNegativeRate() const {
+    return (queries == 0) ? 0 : static_cast<double>(negatives) / queries;
+}
+
+
+// Время работы: O(1)
+inline double FilterStats::GetFalsePositiveRate() const {
+    const size_t absent = negatives + false_positives;
+    return (absent == 0) ? 0 : static_cast<double>(false_positives) / absent;
+}
+
+
+inline FilteredHashTable::FilteredHashTable(size_t initial_size,
+                                            int random_value,
+                                            bool is_incremental)
+        : table(initial_size, random_value, is_incremental),
+          filter(initial_size) {}
+
+
+// Время работы: O(1)
+inline bool FilteredHashTable::MayContain(size_t hash) {
+    stats.queries++;
+    if (!filter.MayContain(hash)) {
+        stats.negatives++;
+        return false;
+    }
+
+    return true;
+}
+
+
+// Время работы: O(1)
+inline void FilteredHashTable::CountResult(bool is_found) {
+    if (!is_found) {
+        stats.false_positives++;
+    }
+}
+
+
+// Амортизированное время работы: O(1)
+inline void FilteredHashTable::GrowFilter() {
+    if (table.Size() <= filter.Capacity()) {
+        return;
+    }
+
+    CountingBloomFilter new_filter(2 * table.Size());
+    table.ForEachKey([&new_filter](const char *data, size_t length) {
+        new_filter.Add(GetStringHash(data, length));
+    });
+    filter = std::move(new_filter);
+}
+
+
+// Время работы: O(key.size())
+inline size_t FilteredHashTable::GetBaseHash(const std::string &key) const {
+    return table.GetBaseHash(key);
+}
+
+
+// Среднее время работы: O(1)
+inline bool FilteredHashTable::Has(const std::string &key) {
+    return Has(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(1)
+inline bool FilteredHashTable::Add(const std::string &key) {
+    return Add(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(1)
+inline bool FilteredHashTable::Remove(const std::string &key) {
+    return Remove(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(key.size())
+inline bool FilteredHashTable::Has(const std::string &key, size_t hash) {
+    if (!MayContain(GetStringHash(key.data(), key.size()))) {
+        return false;
+    }
+
+    const bool is_found = table.Has(key, hash);
+    CountResult(is_found);
+    return is_found;
+}
+
+
+// Среднее амортизированное время работы: O(1)
+inline bool FilteredHashTable::Add(const std::string &key, size_t hash) {
+    if (!table.Add(key, hash)) {
+        return false;
+    }
+
+    filter.Add(GetStringHash(key.data(), key.size()));
+    GrowFilter();
+    return true;
+}
+
+
+// Среднее время работы: O(1)
+inline bool FilteredHashTable::Remove(const std::string &key, size_t hash) {
+    const size_t filter_hash = GetStringHash(key.data(), key.size());
+    if (!MayContain(filter_hash)) {
+        return false;
+    }
+
+    const bool is_found = table.Remove(key, hash);
+    CountResult(is_found);
+    if (is_found) {
+        filter.Remove(filter_hash);
+    }
+    return is_found;
+}
+
+
+// Время работы: O(1)
+inline void FilteredHashTable::Prefetch(size_t hash) const {
+    table.Prefetch(hash);
+}
+
+
+// Время работы: O(1)
+inline size_t FilteredHashTable::Size() const {
+    return table.Size();
+}
+
+
+// Время работы: O(1)
+inline const FilterStats &FilteredHashTable::GetStats() const {
+    return stats;
+}
+
+
+#endif //HOMETASK_8_1_FILTERED_HASH_TABLE_H
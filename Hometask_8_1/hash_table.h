@@ -0,0 +1,779 @@
+// Множество строк на основе хэш-таблицы с открытой адресацией.
+//
+// Для каждой ячейки хранится управляющий байт: пустая ячейка, удаленная или
+// занятая, и тогда в байте хранятся младшие 7 бит хэша ключа. Управляющие
+// байты лежат подряд в отдельном массиве, поэтому при пробировании строки
+// сравниваются, только если совпали фрагмент хэша и полный хэш ключа. Полные
+// хэши хранятся в таблице, и при перехэшировании не вычисляются заново.
+// Символы ключей хранятся в арене (StringArena), а ячейка содержит только
+// ссылку на строку в арене, поэтому на ключ не выделяется отдельная память.
+//
+// Ячейки разбиты на группы по 16 (как в SwissTable): управляющие байты группы
+// сравниваются с фрагментом хэша одной инструкцией SSE2, а на процессорах без
+// SSE2 - побайтовым циклом. Квадратичное пробирование выполняется по группам,
+// поэтому обычно операция завершается после просмотра одной группы.
+//
+// Удаленные ячейки учитываются отдельно от занятых. Когда их становится
+// слишком много, таблица перехэшируется на месте (без выделения памяти), а
+// когда занятых ячеек становится мало - уменьшается в 2 раза. Поэтому
+// длинные потоки добавлений и удалений работают в ограниченной памяти и с
+// короткими последовательностями проб.
+//
+// В режиме постепенного перехэширования (is_incremental) увеличение,
+// уменьшение и очистка таблицы от удаленных ячеек не останавливают работу:
+// старые ячейки остаются рядом с новыми и переносятся в новые по
+// migration_step штук при каждой операции (в т.ч. при поиске). Шаг выбирается
+// так, чтобы перенос закончился раньше, чем новые ячейки заполнятся до
+// порога следующего перехэширования, поэтому ни одна операция не переносит
+// всю таблицу сразу. Пока перенос не закончен, ключ ищется в обеих таблицах.
+
+
+#ifndef HOMETASK_8_1_HASH_TABLE_H
+#define HOMETASK_8_1_HASH_TABLE_H
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "string_arena.h"
+
+// Для отключения SIMD (например, для сравнения) достаточно определить
+// HASH_TABLE_NO_SIMD
+#if defined(__SSE2__) && !defined(HASH_TABLE_NO_SIMD)
+#define HASH_TABLE_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+// Группа управляющих байтов. Методы Match* возвращают битовую маску: i-й бит
+// равен 1, если i-й байт группы удовлетворяет условию
+class ControlGroup {
+private:
+#ifdef HASH_TABLE_USE_SSE2
+    __m128i bytes;
+#else
+    const uint8_t *bytes;
+#endif
+
+public:
+    // Количество ячеек в группе
+    static const size_t width = 16;
+
+    explicit ControlGroup(const uint8_t *control);
+
+    // Байты, равные value
+    uint32_t Match(uint8_t value) const;
+
+    // Байты со старшим битом, т.е. пустые и удаленные ячейки
+    uint32_t MatchEmptyOrDeleted() const;
+};
+
+
+inline ControlGroup::ControlGroup(const uint8_t *control) {
+#ifdef HASH_TABLE_USE_SSE2
+    bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(control));
+#else
+    bytes = control;
+#endif
+}
+
+
+// Время работы: O(1) (O(width) без SSE2)
+inline uint32_t ControlGroup::Match(uint8_t value) const {
+#ifdef HASH_TABLE_USE_SSE2
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(value));
+    return static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, pattern)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < width; i++) {
+        mask |= static_cast<uint32_t>(bytes[i] == value) << i;
+    }
+    return mask;
+#endif
+}
+
+
+// Время работы: O(1) (O(width) без SSE2)
+inline uint32_t ControlGroup::MatchEmptyOrDeleted() const {
+#ifdef HASH_TABLE_USE_SSE2
+    return static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < width; i++) {
+        mask |= static_cast<uint32_t>(bytes[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+
+// Номер младшего единичного бита ненулевой маски
+// Время работы: O(1)
+inline size_t LowestBit(uint32_t mask) {
+    assert(mask != 0);
+
+    return static_cast<size_t>(__builtin_ctz(mask));
+}
+
+
+class HashTable {
+private:
+    // Значения управляющего байта. У занятой ячейки старший бит равен нулю,
+    // а младшие 7 бит - фрагмент хэша ключа
+    enum : uint8_t {
+        empty_slot = 0x80,
+        deleted_slot = 0xFE
+    };
+    // Количество бит хэша, хранящихся в управляющем байте
+    static const int fragment_bits = 7;
+    // Минимальное количество старых ячеек, переносимых за одну операцию
+    static const size_t min_migration_step = 2 * ControlGroup::width;
+
+    // Ячейки таблицы. Заполняются только управляющие байты: хэши и ссылки
+    // занятых ячеек записываются при вставке, поэтому выделение новых
+    // ячеек при постепенном перехэшировании не проходит по всей памяти
+    struct Slots {
+        // Управляющие байты ячеек
+        std::unique_ptr<uint8_t[]> control;
+        // Полные хэши ключей занятых ячеек
+        std::unique_ptr<size_t[]> hashes;
+        // Ссылки на ключи в арене
+        std::unique_ptr<StringRef[]> table;
+        size_t size = 0;
+        // Количество групп - степень двойки, group_mask = количество групп - 1
+        size_t group_mask = 0;
+
+        // Создать size пустых ячеек
+        void Assign(size_t size);
+
+        // Освободить память ячеек
+        void Clear();
+
+        size_t Size() const;
+
+        // Следующая группа в последовательности проб
+        size_t GetNewHash(size_t current_hash, size_t current_iter) const;
+
+        // Группа, с которой начинается пробирование для хэша hash
+        size_t GetStartGroup(size_t hash) const;
+
+        // Группа управляющих байтов с номером group
+        ControlGroup GetGroup(size_t group) const;
+
+        // Первая пустая ячейка на пути пробирования для хэша hash
+        size_t FindEmpty(size_t hash) const;
+    };
+
+    Slots slots;
+    // Старые ячейки во время постепенного перехэширования (иначе пусты).
+    // Ячейки с номерами меньше migrate_pos уже перенесены
+    Slots old_slots;
+    size_t migrate_pos = 0;
+    // Количество старых ячеек, переносимых за одну операцию
+    size_t migration_step = min_migration_step;
+    StringArena arena;
+    // Размер, меньше которого таблица не уменьшается
+    size_t min_size;
+    const int random_value;
+    const bool is_incremental;
+    // Максимальная доля непустых (занятых и удаленных) ячеек
+    const float max_fill_coef;
+    // Максимальная доля удаленных ячеек
+    const float max_deleted_coef;
+    // Доля занятых ячеек, при которой таблица уменьшается
+    const float min_fill_coef;
+    // Количество ключей в обеих таблицах
+    size_t live_size = 0;
+    // Количество ключей, еще не перенесенных из старой таблицы
+    size_t old_live_size = 0;
+    // Количество удаленных ячеек в slots
+    size_t deleted_size = 0;
+
+    // Снимок читает ячейки таблицы и использует ту же хэш-функцию
+    friend class HashTableSnapshot;
+
+    // Управляющий байт занятой ячейки с ключом, имеющим хэш hash
+    static uint8_t GetFragment(size_t hash);
+
+    // Хэш ключа key при параметре многочлена random_value_
+    static size_t GetBaseHash(const std::string &key, int random_value_);
+
+    // Позиция ключа key с хэшем hash в ячейках slots_, -1 - если ключа нет
+    size_t Find(const Slots &slots_, const std::string &key, size_t hash) const;
+
+    // Изменить размер таблицы на new_size: сразу или постепенно, в
+    // зависимости от режима
+    void Resize(size_t new_size);
+
+    // Перенести ключи в новую таблицу размера new_size
+    void Rehash(size_t new_size);
+
+    // Перехэшировать таблицу на месте, превратив удаленные ячейки в пустые
+    void PurgeDeleted();
+
+    // Перенести очередные migration_step старых ячеек
+    void MigrateStep();
+
+    // Переложить ключи в новую арену, если в старой много удаленных строк
+    void CompactArena();
+
+public:
+    HashTable(size_t initial_size, int random_value_,
+              bool is_incremental_ = false);
+
+    // Констурктор копирования
+    HashTable(const HashTable &) = delete;
+
+    // Конструктор перемещения
+    HashTable(HashTable &&) = delete;
+
+    // Оператор присваивания копированием
+    HashTable &operator=(const HashTable &) = delete;
+
+    // Оператор присваивания перемещением
+    HashTable &operator=(HashTable &&) = delete;
+
+    // Во время постепенного перехэширования поиск тоже переносит ячейки,
+    // поэтому Has не константный
+    bool Has(const std::string &key);
+
+    bool Add(const std::string &key);
+
+    bool Remove(const std::string &key);
+
+    size_t GetBaseHash(const std::string &key) const;
+
+    // Операции с уже вычисленным хэшем hash = GetBaseHash(key)
+    bool Has(const std::string &key, size_t hash);
+
+    bool Add(const std::string &key, size_t hash);
+
+    bool Remove(const std::string &key, size_t hash);
+
+    // Предвыборка в кэш первой группы ячеек для хэша hash (перед пакетом
+    // операций)
+    void Prefetch(size_t hash) const;
+
+    // Вызвать callback(data, length) для символов каждого ключа множества
+    template<typename TCallback>
+    void ForEachKey(TCallback callback) const;
+
+    // Количество ключей в множестве
+    size_t Size() const;
+
+    // Количество ячеек таблицы (без старых ячеек, ожидающих переноса)
+    size_t Capacity() const;
+};
+
+
+// Время работы: O(size)
+inline void HashTable::Slots::Assign(size_t size) {
+    assert((size > 0) && (size % ControlGroup::width == 0));
+
+    control.reset(new uint8_t[size]);
+    std::fill(control.get(), control.get() + size, empty_slot);
+    hashes.reset(new size_t[size]);
+    table.reset(new StringRef[size]);
+    this->size = size;
+    group_mask = size / ControlGroup::width - 1;
+}
+
+
+// Время работы: O(1)
+inline void HashTable::Slots::Clear() {
+    control.reset();
+    hashes.reset();
+    table.reset();
+    size = 0;
+    group_mask = 0;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTable::Slots::Size() const {
+    return size;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTable::Slots::GetNewHash(size_t current_hash,
+                                           size_t current_iter) const {
+    return (current_hash + (current_iter + 1)) & group_mask;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTable::Slots::GetStartGroup(size_t hash) const {
+    return (hash >> fragment_bits) & group_mask;
+}
+
+
+// Время работы: O(1)
+inline ControlGroup HashTable::Slots::GetGroup(size_t group) const {
+    return ControlGroup(control.get() + group * ControlGroup::width);
+}
+
+
+// Среднее время работы: O(1)
+inline size_t HashTable::Slots::FindEmpty(size_t hash) const {
+    size_t group = GetStartGroup(hash);
+    uint32_t empty = GetGroup(group).Match(empty_slot);
+    for (size_t i = 0; empty == 0; i++) {
+        group = GetNewHash(group, i);
+        empty = GetGroup(group).Match(empty_slot);
+    }
+
+    return group * ControlGroup::width + LowestBit(empty);
+}
+
+
+inline HashTable::HashTable(size_t initial_size, int random_value_,
+                            bool is_incremental_)
+        : min_size(0),
+          random_value(random_value_),
+          is_incremental(is_incremental_),
+          max_fill_coef(0.75),
+          max_deleted_coef(0.25),
+          min_fill_coef(0.125) {
+    assert(initial_size > 0);
+
+    // Размер таблицы округляется вверх до степени двойки, но не меньше
+    // одной группы
+    size_t size = ControlGroup::width;
+    while (size < initial_size) {
+        size *= 2;
+    }
+
+    slots.Assign(size);
+    min_size = size;
+}
+
+
+// Время работы: O(key.size()) (для коротких key считаем, что O(1))
+inline size_t HashTable::GetBaseHash(const std::string &key) const {
+    return GetBaseHash(key, random_value);
+}
+
+
+// Время работы: O(key.size()) (для коротких key считаем, что O(1))
+inline size_t HashTable::GetBaseHash(const std::string &key,
+                                     int random_value_) {
+    assert(!key.empty());
+    size_t hash = 0;
+
+    // Многочлен по модулю 2^64 (переполнение size_t)
+    for (char ch : key) {
+        hash = hash * random_value_ + ch;
+    }
+
+    // Перемешивание битов (финализатор MurmurHash3): младшие биты многочлена
+    // зависят только от младших битов символов, а позиция в таблице и
+    // фрагмент берутся именно из младших битов
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+
+// Время работы: O(1)
+inline uint8_t HashTable::GetFragment(size_t hash) {
+    return static_cast<uint8_t>(hash & ((1u << fragment_bits) - 1));
+}
+
+
+// Среднее время работы: O(1)
+inline size_t HashTable::Find(const Slots &slots_, const std::string &key,
+                              size_t hash) const {
+    const uint8_t fragment = GetFragment(hash);
+    size_t group = slots_.GetStartGroup(hash);
+
+    for (size_t i = 0; i <= slots_.group_mask; i++) {
+        const ControlGroup control_group = slots_.GetGroup(group);
+
+        // Строки сравниваются, только если совпали фрагмент и полный хэш
+        for (uint32_t match = control_group.Match(fragment); match != 0;
+             match &= match - 1) {
+            const size_t pos = group * ControlGroup::width + LowestBit(match);
+            if ((slots_.hashes[pos] == hash) &&
+                arena.IsEqual(slots_.table[pos], key)) {
+                return pos;
+            }
+        }
+
+        // В группе есть ячейка, которая была и есть пуста
+        if (control_group.Match(empty_slot) != 0) {
+            return -1;
+        }
+        group = slots_.GetNewHash(group, i);
+    }
+
+    throw std::overflow_error("");
+}
+
+
+// Время работы: O(1) в режиме постепенного перехэширования, иначе
+// O(slots.Size() + new_size)
+inline void HashTable::Resize(size_t new_size) {
+    assert(old_slots.Size() == 0);
+
+    if (new_size == slots.Size()) {
+        // Размер не меняется: достаточно убрать удаленные ячейки
+        if (!is_incremental) {
+            PurgeDeleted();
+            return;
+        }
+    } else if (!is_incremental) {
+        Rehash(new_size);
+        return;
+    }
+
+    // Текущие ячейки становятся старыми и будут переноситься по частям
+    old_slots = std::move(slots);
+    slots.Assign(new_size);
+    migrate_pos = 0;
+    old_live_size = live_size;
+    deleted_size = 0;
+
+    // Каждая операция во время переноса добавляет в новые ячейки не больше
+    // одной непустой ячейки сверх перенесенных ключей. Перенос заканчивается
+    // не больше чем за половину операций, оставшихся до порога заполнения
+    // новых ячеек
+    const size_t fill_limit = static_cast<size_t>(max_fill_coef * new_size);
+    assert(live_size < fill_limit);
+    const size_t max_operations = std::max<size_t>(
+            (fill_limit - live_size) / 2, 1);
+    migration_step = (old_slots.Size() + max_operations - 1) / max_operations;
+    if (migration_step < min_migration_step) {
+        migration_step = min_migration_step;
+    }
+}
+
+
+// Время работы: O(slots.Size() + new_size)
+inline void HashTable::Rehash(size_t new_size) {
+    assert(live_size < new_size);
+
+    // Сохраняем старые ячейки
+    Slots previous = std::move(slots);
+
+    // Создаем новые ячейки размера new_size
+    slots.Assign(new_size);
+
+    // Удаленные ячейки не переносятся
+    deleted_size = 0;
+
+    // Переносим ключи в новые ячейки: все ключи различны, поэтому каждый
+    // ставится в первую пустую ячейку без сравнения строк
+    for (size_t i = 0; i < previous.Size(); i++) {
+        if ((previous.control[i] & empty_slot) != 0) {
+            continue;
+        }
+
+        const size_t pos = slots.FindEmpty(previous.hashes[i]);
+        slots.control[pos] = previous.control[i];
+        slots.hashes[pos] = previous.hashes[i];
+        slots.table[pos] = previous.table[i];
+    }
+
+    CompactArena();
+}
+
+
+// Время работы: O(slots.Size())
+inline void HashTable::PurgeDeleted() {
+    uint8_t *control = slots.control.get();
+    size_t *hashes = slots.hashes.get();
+    StringRef *table = slots.table.get();
+
+    // Удаленные ячейки становятся пустыми, а занятые помечаются как
+    // удаленные - это ключи, которые еще предстоит поставить на место
+    for (size_t i = 0; i < slots.Size(); i++) {
+        control[i] = ((control[i] & empty_slot) != 0) ? empty_slot
+                                                      : deleted_slot;
+    }
+
+    for (size_t i = 0; i < slots.Size(); i++) {
+        if (control[i] != deleted_slot) {
+            continue;
+        }
+
+        // Первая пустая или еще не обработанная ячейка на пути пробирования
+        size_t group = slots.GetStartGroup(hashes[i]);
+        uint32_t free_slots = slots.GetGroup(group).MatchEmptyOrDeleted();
+        for (size_t j = 0; free_slots == 0; j++) {
+            group = slots.GetNewHash(group, j);
+            free_slots = slots.GetGroup(group).MatchEmptyOrDeleted();
+        }
+        const size_t pos = group * ControlGroup::width + LowestBit(free_slots);
+
+        // Ключ уже в первой подходящей группе и остается на месте
+        if (group == i / ControlGroup::width) {
+            control[i] = GetFragment(hashes[i]);
+            continue;
+        }
+
+        if (control[pos] == empty_slot) {
+            // Переносим ключ в пустую ячейку
+            control[pos] = GetFragment(hashes[i]);
+            hashes[pos] = hashes[i];
+            table[pos] = table[i];
+            control[i] = empty_slot;
+            table[i] = StringRef();
+        } else {
+            // В ячейке pos необработанный ключ: меняем ключи местами и
+            // обрабатываем ячейку i еще раз
+            control[pos] = GetFragment(hashes[i]);
+            std::swap(hashes[pos], hashes[i]);
+            std::swap(table[pos], table[i]);
+            i--;
+        }
+    }
+
+    deleted_size = 0;
+    CompactArena();
+}
+
+
+// Время работы: O(migration_step)
+inline void HashTable::MigrateStep() {
+    const size_t end = std::min(migrate_pos + migration_step,
+                                old_slots.Size());
+    for (; migrate_pos < end; migrate_pos++) {
+        if ((old_slots.control[migrate_pos] & empty_slot) != 0) {
+            continue;
+        }
+
+        // Ключа нет в новых ячейках, поэтому он ставится в первую пустую
+        const size_t hash = old_slots.hashes[migrate_pos];
+        const size_t pos = slots.FindEmpty(hash);
+        slots.control[pos] = old_slots.control[migrate_pos];
+        slots.hashes[pos] = hash;
+        slots.table[pos] = old_slots.table[migrate_pos];
+
+        // В старых ячейках ключ становится удаленным, чтобы не прерывать
+        // цепочки проб остальных старых ключей
+        old_slots.control[migrate_pos] = deleted_slot;
+        old_live_size--;
+    }
+
+    if (migrate_pos == old_slots.Size()) {
+        assert(old_live_size == 0);
+        old_slots.Clear();
+        migrate_pos = 0;
+        CompactArena();
+    }
+}
+
+
+// Время работы: O(размер таблиц + суммарная длина ключей)
+inline void HashTable::CompactArena() {
+    if (!arena.IsCompactionNeeded()) {
+        return;
+    }
+
+    StringArena new_arena;
+    for (Slots *slots_ : {&slots, &old_slots}) {
+        for (size_t i = 0; i < slots_->Size(); i++) {
+            if ((slots_->control[i] & empty_slot) == 0) {
+                slots_->table[i] = arena.CopyTo(slots_->table[i], new_arena);
+            }
+        }
+    }
+    arena = std::move(new_arena);
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Has(const std::string &key) {
+    return Has(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Add(const std::string &key) {
+    return Add(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Remove(const std::string &key) {
+    return Remove(key, GetBaseHash(key));
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Has(const std::string &key, size_t hash) {
+    assert(hash == GetBaseHash(key));
+
+    if (old_slots.Size() != 0) {
+        MigrateStep();
+    }
+
+    return (Find(slots, key, hash) != static_cast<size_t>(-1)) ||
+           ((old_slots.Size() != 0) &&
+            (Find(old_slots, key, hash) != static_cast<size_t>(-1)));
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Add(const std::string &key, size_t hash) {
+    assert(hash == GetBaseHash(key));
+
+    if (old_slots.Size() != 0) {
+        MigrateStep();
+        if ((old_slots.Size() != 0) &&
+            (Find(old_slots, key, hash) != static_cast<size_t>(-1))) {
+            return false;
+        }
+    }
+
+    const uint8_t fragment = GetFragment(hash);
+    size_t group = slots.GetStartGroup(hash);
+
+    // Позиция, в которую будет вставлен текущий ключ, если он еще отсутствует
+    size_t pos_for_insert = -1;
+    // Флажок, принимающий значение true, когда найдена pos_for_insert
+    bool is_pos_found = false;
+
+    for (size_t i = 0; i <= slots.group_mask; i++) {
+        const ControlGroup control_group = slots.GetGroup(group);
+
+        // Сейчас в одной из ячеек группы текущий ключ
+        for (uint32_t match = control_group.Match(fragment); match != 0;
+             match &= match - 1) {
+            const size_t pos = group * ControlGroup::width + LowestBit(match);
+            if ((slots.hashes[pos] == hash) &&
+                arena.IsEqual(slots.table[pos], key)) {
+                return false;
+            }
+        }
+
+        // Первая пустая или удаленная ячейка на пути пробирования
+        const uint32_t free_slots = control_group.MatchEmptyOrDeleted();
+        if ((free_slots != 0) && !is_pos_found) {
+            pos_for_insert = group * ControlGroup::width +
+                             LowestBit(free_slots);
+            is_pos_found = true;
+        }
+
+        // В группе есть ячейка, которая была и есть пуста
+        if (control_group.Match(empty_slot) != 0) {
+            if (slots.control[pos_for_insert] == deleted_slot) {
+                deleted_size--;
+            }
+
+            slots.control[pos_for_insert] = fragment;
+            slots.hashes[pos_for_insert] = hash;
+            slots.table[pos_for_insert] = arena.Add(key);
+            live_size++;
+
+            // Если занятых ячеек много, таблица увеличивается, иначе место
+            // освобождается удалением удаленных ячеек. Во время переноса
+            // размер не меняется, но шаг переноса выбран так, что к порогу
+            // заполнения перенос уже закончен
+            const size_t filled = live_size - old_live_size + deleted_size;
+            if ((old_slots.Size() == 0) &&
+                (filled >= max_fill_coef * slots.Size())) {
+                if (live_size >= max_fill_coef / 2 * slots.Size()) {
+                    Resize(slots.Size() * 2);
+                } else {
+                    Resize(slots.Size());
+                }
+            }
+            return true;
+        }
+        group = slots.GetNewHash(group, i);
+    }
+
+    throw std::overflow_error("");
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTable::Remove(const std::string &key, size_t hash) {
+    assert(hash == GetBaseHash(key));
+
+    if (old_slots.Size() != 0) {
+        MigrateStep();
+    }
+
+    size_t pos = Find(slots, key, hash);
+    if (pos != static_cast<size_t>(-1)) {
+        slots.control[pos] = deleted_slot;
+        arena.Release(slots.table[pos]);
+        slots.table[pos] = StringRef();
+        deleted_size++;
+    } else {
+        // Ключ может быть еще не перенесен
+        if (old_slots.Size() != 0) {
+            pos = Find(old_slots, key, hash);
+        }
+        if (pos == static_cast<size_t>(-1)) {
+            return false;
+        }
+
+        old_slots.control[pos] = deleted_slot;
+        arena.Release(old_slots.table[pos]);
+        old_slots.table[pos] = StringRef();
+        old_live_size--;
+    }
+    live_size--;
+
+    // Во время переноса размер таблицы не меняется
+    if (old_slots.Size() != 0) {
+        return true;
+    }
+
+    if ((slots.Size() > min_size) &&
+        (live_size <= min_fill_coef * slots.Size())) {
+        Resize(slots.Size() / 2);
+    } else if (deleted_size >= max_deleted_coef * slots.Size()) {
+        Resize(slots.Size());
+    }
+    return true;
+}
+
+
+// Время работы: O(1)
+inline void HashTable::Prefetch(size_t hash) const {
+    const size_t pos = slots.GetStartGroup(hash) * ControlGroup::width;
+    __builtin_prefetch(slots.control.get() + pos);
+    __builtin_prefetch(slots.hashes.get() + pos);
+}
+
+
+// Время работы: O(размер таблиц + суммарная длина ключей)
+template<typename TCallback>
+void HashTable::ForEachKey(TCallback callback) const {
+    for (const Slots *slots_ : {&slots, &old_slots}) {
+        for (size_t i = 0; i < slots_->Size(); i++) {
+            if ((slots_->control[i] & empty_slot) == 0) {
+                const StringRef ref = slots_->table[i];
+                callback(arena.GetData(ref), static_cast<size_t>(ref.length));
+            }
+        }
+    }
+}
+
+
+// Время работы: O(1)
+inline size_t HashTable::Size() const {
+    return live_size;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTable::Capacity() const {
+    return slots.Size();
+}
+
+
+#endif //HOMETASK_8_1_HASH_TABLE_H
@@ -0,0 +1,344 @@
+// Снимок множества строк на диске и чтение снимка через mmap.
+//
+// Save записывает ячейки таблицы (управляющие байты, полные хэши и ссылки на
+// ключи) и все ключи одним блоком символов. Ключи переставляются в таблицу
+// того же размера без удаленных ячеек, поэтому снимок можно сохранить и во
+// время постепенного перехэширования.
+//
+// HashTableSnapshot открывает файл снимка только для чтения за O(1): файл
+// отображается в память целиком, и ничего не перестраивается и не
+// просматривается. При открытии проверяются только размеры из заголовка,
+// поэтому обрезанный файл отвергается. Ссылка на ключ проверяется в Has перед
+// сравнением строк: ключ за пределами блока символов не читается, а Has
+// бросает runtime_error. Поиск выполняется по тем же группам ячеек и с той же
+// хэш-функцией, что и в HashTable.
+//
+// Save записывает снимок во временный файл и заменяет им файл снимка через
+// rename, поэтому сбой во время записи не портит прежний снимок.
+//
+// Формат файла (порядок байтов и выравнивание - как у процессора, на котором
+// снимок записан): Header, управляющие байты slot_count ячеек, хэши
+// slot_count ячеек, Key slot_count ячеек, символы ключей.
+
+
+#ifndef HOMETASK_8_1_HASH_TABLE_SNAPSHOT_H
+#define HOMETASK_8_1_HASH_TABLE_SNAPSHOT_H
+
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hash_table.h"
+
+
+class HashTableSnapshot {
+private:
+    // Заголовок файла
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        // Параметр хэш-функции таблицы
+        int32_t random_value;
+        // Количество ячеек - степень двойки, не меньше ControlGroup::width
+        uint64_t slot_count;
+        // Количество ключей
+        uint64_t size;
+        // Суммарная длина ключей
+        uint64_t blob_size;
+    };
+
+    // Положение ключа в блоке символов
+    struct Key {
+        uint64_t offset;
+        uint64_t length;
+    };
+
+    static const uint32_t version = 1;
+
+    // Отображенный в память файл
+    void *data;
+    size_t data_size;
+    const Header *header;
+    const uint8_t *control;
+    const uint64_t *hashes;
+    const Key *keys;
+    const char *blob;
+    size_t group_mask;
+
+    // Размер данных одной ячейки: управляющий байт, хэш и ссылка на ключ
+    static const size_t slot_bytes = sizeof(uint8_t) + sizeof(uint64_t) +
+                                     sizeof(Key);
+
+    static const char *GetMagic();
+
+    // Размеры из заголовка header_ согласованы с размером файла data_size_
+    static bool IsSizeValid(const Header &header_, size_t data_size_);
+
+    // Ключ key лежит внутри блока символов
+    bool IsKeyValid(const Key &key) const;
+
+    // Освободить отображение и бросить runtime_error
+    [[noreturn]] void Reject(const std::string &message);
+
+public:
+    // Открыть снимок из файла path, при ошибке бросается runtime_error
+    explicit HashTableSnapshot(const std::string &path);
+
+    // Констурктор копирования
+    HashTableSnapshot(const HashTableSnapshot &) = delete;
+
+    // Конструктор перемещения
+    HashTableSnapshot(HashTableSnapshot &&) = delete;
+
+    // Оператор присваивания копированием
+    HashTableSnapshot &operator=(const HashTableSnapshot &) = delete;
+
+    // Оператор присваивания перемещением
+    HashTableSnapshot &operator=(HashTableSnapshot &&) = delete;
+
+    ~HashTableSnapshot();
+
+    // Записать снимок таблицы table в файл path, при ошибке бросается
+    // runtime_error
+    static void Save(const HashTable &table, const std::string &path);
+
+    // При ссылке на ключ за пределами блока символов (поврежденный снимок)
+    // бросается runtime_error
+    bool Has(const std::string &key) const;
+
+    // Количество ключей в множестве
+    size_t Size() const;
+
+    // Количество ячеек таблицы
+    size_t Capacity() const;
+};
+
+
+// Время работы: O(1)
+inline const char *HashTableSnapshot::GetMagic() {
+    // 8 символов без завершающего нуля
+    return "HT81SNAP";
+}
+
+
+// Время работы: O(1)
+inline bool HashTableSnapshot::IsSizeValid(const Header &header_,
+                                           size_t data_size_) {
+    // Размеры из заголовка не складываются и не умножаются, пока не
+    // проверено, что ячейки помещаются в файл: иначе подобранный заголовок
+    // переполнит uint64_t и пройдет проверку размера файла
+    const uint64_t rest = data_size_ - sizeof(Header);
+    if (header_.slot_count > rest / slot_bytes) {
+        return false;
+    }
+
+    return header_.blob_size == rest - header_.slot_count * slot_bytes;
+}
+
+
+// Время работы: O(1)
+inline HashTableSnapshot::HashTableSnapshot(const std::string &path)
+        : data(nullptr), data_size(0), header(nullptr), control(nullptr),
+          hashes(nullptr), keys(nullptr), blob(nullptr), group_mask(0) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open snapshot " + path);
+    }
+
+    struct stat file_stat;
+    if ((fstat(fd, &file_stat) != 0) ||
+        (static_cast<size_t>(file_stat.st_size) < sizeof(Header))) {
+        close(fd);
+        throw std::runtime_error("invalid snapshot " + path);
+    }
+    data_size = static_cast<size_t>(file_stat.st_size);
+
+    data = mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // Отображение остается действительным и после закрытия файла
+    close(fd);
+    if (data == MAP_FAILED) {
+        data = nullptr;
+        throw std::runtime_error("cannot map snapshot " + path);
+    }
+
+    header = static_cast<const Header *>(data);
+    const uint64_t slot_count = header->slot_count;
+    if ((std::memcmp(header->magic, GetMagic(), sizeof(header->magic)) != 0) ||
+        (header->version != version) ||
+        (slot_count < ControlGroup::width) ||
+        ((slot_count & (slot_count - 1)) != 0) ||
+        (header->size >= slot_count) ||
+        !IsSizeValid(*header, data_size)) {
+        Reject("invalid snapshot " + path);
+    }
+
+    // Размер заголовка и количество ячеек кратны 8, поэтому хэши и ссылки
+    // выровнены
+    const char *bytes = static_cast<const char *>(data);
+    control = reinterpret_cast<const uint8_t *>(bytes + sizeof(Header));
+    hashes = reinterpret_cast<const uint64_t *>(control + slot_count);
+    keys = reinterpret_cast<const Key *>(hashes + slot_count);
+    blob = reinterpret_cast<const char *>(keys + slot_count);
+    group_mask = slot_count / ControlGroup::width - 1;
+}
+
+
+// Время работы: O(1)
+inline bool HashTableSnapshot::IsKeyValid(const Key &key) const {
+    // Сравнение без сложения offset + length, которое может переполниться
+    return (key.offset <= header->blob_size) &&
+           (key.length <= header->blob_size - key.offset);
+}
+
+
+inline void HashTableSnapshot::Reject(const std::string &message) {
+    munmap(data, data_size);
+    data = nullptr;
+    throw std::runtime_error(message);
+}
+
+
+// Время работы: O(1)
+inline HashTableSnapshot::~HashTableSnapshot() {
+    if (data) {
+        munmap(data, data_size);
+    }
+}
+
+
+// Время работы: O(размер таблицы + суммарная длина ключей)
+inline void HashTableSnapshot::Save(const HashTable &table,
+                                    const std::string &path) {
+    // Ключи обеих таблиц переставляются в ячейки размера новой таблицы: во
+    // время переноса ключей меньше половины ее ячеек
+    HashTable::Slots layout;
+    layout.Assign(table.slots.Size());
+    for (const HashTable::Slots *slots_ : {&table.slots, &table.old_slots}) {
+        for (size_t i = 0; i < slots_->Size(); i++) {
+            if ((slots_->control[i] & HashTable::empty_slot) != 0) {
+                continue;
+            }
+
+            const size_t pos = layout.FindEmpty(slots_->hashes[i]);
+            layout.control[pos] = slots_->control[i];
+            layout.hashes[pos] = slots_->hashes[i];
+            layout.table[pos] = slots_->table[i];
+        }
+    }
+
+    Header header_;
+    std::memcpy(header_.magic, GetMagic(), sizeof(header_.magic));
+    header_.version = version;
+    header_.random_value = table.random_value;
+    header_.slot_count = layout.Size();
+    header_.size = table.Size();
+    header_.blob_size = 0;
+
+    // Хэши и положения ключей в блоке символов; ключи лежат в порядке ячеек
+    std::vector<uint64_t> hashes_(layout.Size(), 0);
+    std::vector<Key> keys_(layout.Size(), Key{0, 0});
+    for (size_t i = 0; i < layout.Size(); i++) {
+        if ((layout.control[i] & HashTable::empty_slot) != 0) {
+            continue;
+        }
+
+        hashes_[i] = layout.hashes[i];
+        keys_[i].offset = header_.blob_size;
+        keys_[i].length = layout.table[i].length;
+        header_.blob_size += layout.table[i].length;
+    }
+
+    // Снимок пишется во временный файл, который после записи на диск
+    // заменяет прежний снимок
+    const std::string temp_path = path + ".tmp";
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+    file.write(reinterpret_cast<const char *>(layout.control.get()),
+               layout.Size());
+    file.write(reinterpret_cast<const char *>(hashes_.data()),
+               hashes_.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(keys_.data()),
+               keys_.size() * sizeof(Key));
+    for (size_t i = 0; i < layout.Size(); i++) {
+        if ((layout.control[i] & HashTable::empty_slot) == 0) {
+            file.write(table.arena.GetData(layout.table[i]),
+                       layout.table[i].length);
+        }
+    }
+
+    file.close();
+    bool is_written = static_cast<bool>(file);
+    if (is_written) {
+        // ofstream не дает дескриптор, поэтому файл открывается еще раз
+        const int fd = open(temp_path.c_str(), O_RDONLY);
+        is_written = (fd >= 0) && (fsync(fd) == 0);
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    if (!is_written || (std::rename(temp_path.c_str(), path.c_str()) != 0)) {
+        std::remove(temp_path.c_str());
+        throw std::runtime_error("cannot write snapshot " + path);
+    }
+}
+
+
+// Среднее время работы: O(1)
+inline bool HashTableSnapshot::Has(const std::string &key) const {
+    const size_t hash = HashTable::GetBaseHash(key, header->random_value);
+    const uint8_t fragment = HashTable::GetFragment(hash);
+    size_t group = (hash >> HashTable::fragment_bits) & group_mask;
+
+    for (size_t i = 0; i <= group_mask; i++) {
+        const ControlGroup control_group(control + group * ControlGroup::width);
+
+        for (uint32_t match = control_group.Match(fragment); match != 0;
+             match &= match - 1) {
+            const size_t pos = group * ControlGroup::width + LowestBit(match);
+            if ((hashes[pos] != hash) || (keys[pos].length != key.size())) {
+                continue;
+            }
+            if (!IsKeyValid(keys[pos])) {
+                throw std::runtime_error("corrupt snapshot");
+            }
+            if (std::memcmp(blob + keys[pos].offset, key.data(),
+                            key.size()) == 0) {
+                return true;
+            }
+        }
+
+        // В снимке нет удаленных ячеек, поэтому пустая ячейка завершает поиск
+        if (control_group.Match(HashTable::empty_slot) != 0) {
+            return false;
+        }
+        group = (group + (i + 1)) & group_mask;
+    }
+
+    return false;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTableSnapshot::Size() const {
+    return header->size;
+}
+
+
+// Время работы: O(1)
+inline size_t HashTableSnapshot::Capacity() const {
+    return header->slot_count;
+}
+
+
+#endif //HOMETASK_8_1_HASH_TABLE_SNAPSHOT_H
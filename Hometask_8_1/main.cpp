@@ -44,232 +44,174 @@
 // Потребляемая память: O(n), где n - количество операций со множеством
 
 
-#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <stdexcept>
 #include <string>
-#include <vector>
 
+#include "fast_input.h"
+#include "fast_output.h"
+#include "filtered_hash_table.h"
+#include "hash_table.h"
+#include "hash_table_snapshot.h"
+#include "set_command_engine.h"
 
-using std::cin;
-using std::cout;
-using std::endl;
-using std::move;
-using std::overflow_error;
-using std::string;
-using std::vector;
 
+// Файл снимка для Test (в текущей директории)
+const char snapshot_test_path[] = "hash_table_snapshot.test";
 
-class HashTable {
-private:
-    // Вектор флажков, обозначающих удаленные элементы
-    vector<bool> deleted;
 
-    vector<string> table;
-    const int random_value;
-    const float max_fill_coef;
-    double current_size = 0;
-
-    size_t GetBaseHash(const string &key) const;
-
-    size_t GetNewHash(size_t current_hash, size_t current_iter) const;
-
-    void Rehash();
-
-public:
-    HashTable(size_t initial_size, int random_value_);
-
-    // Констурктор копирования
-    HashTable(const HashTable &) = delete;
-
-    // Конструктор перемещения
-    HashTable(HashTable &&) = delete;
-
-    // Оператор присваивания копированием
-    HashTable &operator=(const HashTable &) = delete;
-
-    // Оператор присваивания перемещением
-    HashTable &operator=(HashTable &&) = delete;
-
-    bool Has(const string &key) const;
-
-    bool Add(const string &key);
-
-    bool Remove(const string &key);
-};
-
-
-HashTable::HashTable(size_t initial_size, int random_value_)
-        : table(initial_size, ""),
-          deleted(initial_size, false),
-          random_value(random_value_),
-          max_fill_coef(0.75) {}
-
-
-// Время работы: O(key.size()) (для коротких key считаем, что O(1))
-size_t HashTable::GetBaseHash(const string &key) const {
-    assert(!key.empty());
-    size_t hash = 0;
-
-    for (char ch : key) {
-        hash = (hash * random_value + ch) % table.size();
-    }
-
-    return hash;
+// Записать байты data в файл path целиком
+void WriteTestFile(const std::string &path, const std::string &data) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), data.size());
 }
 
 
-// Время работы: O(1)
-size_t HashTable::GetNewHash(size_t current_hash, size_t current_iter) const {
-    assert(current_hash >= 0);
-
-    return (current_hash + (current_iter + 1)) % table.size();
-}
-
-
-// Время работы: O(table.size())
-void HashTable::Rehash() {
-    // Сохраняем старые значения векторов
-    auto old_table = move(table);
-    auto old_deleted = move(deleted);
-
-    // Создаем новые вектора в 2 раза больше
-    table.assign(old_table.size() * 2, "");
-    deleted.assign(old_table.size() * 2, false);
-
-    // Обнуляем количество хранимых элементов
-    current_size = 0;
-
-    // Переносим ключи в новый вектор
-    for (size_t i = 0; i < old_table.size(); i++) {
-        if ((!old_table[i].empty()) && (!old_deleted[i])) {
-            Add(old_table[i]);
-        }
-    }
+// Прочитать файл path целиком
+std::string ReadTestFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
 }
 
 
-// Среднее время работы: O(1)
-bool HashTable::Has(const string &key) const {
-    size_t hash = GetBaseHash(key);
-
-    for (size_t i = 0; i < table.size(); i++) {
-        // Ячейка была и есть пуста
-        if (table[hash].empty()) {
-            assert(!deleted[hash]);
-            return false;
-        }
-
-        // Сейчас в этой ячейке текущий ключ
-        if ((table[hash] == key) && (!deleted[hash])) {
-            return true;
-        }
-
-        // Раньше в этой ячейке был текущий ключ
-        if ((table[hash] == key) && (deleted[hash])) {
-            return false;
-        }
-        hash = GetNewHash(hash, i);
+// Открытие снимка из файла с содержимым data бросает runtime_error
+bool IsSnapshotRejected(const std::string &data) {
+    WriteTestFile(snapshot_test_path, data);
+    try {
+        HashTableSnapshot snapshot(snapshot_test_path);
+    } catch (const std::runtime_error &) {
+        return true;
     }
 
-    throw overflow_error("");
+    return false;
 }
 
 
-// Среднее время работы: O(1)
-bool HashTable::Add(const string &key) {
-    size_t hash = GetBaseHash(key);
-
-    // Позиция, в которую будет вставлен текущий ключ, если он еще отсутствует
-    size_t pos_for_insert = -1;
-    // Флажок, принимающий значение true, когда найдена pos_for_insert
-    bool is_pos_found = false;
-
-    for (size_t i = 0; i < table.size(); i++) {
-        // Ячейка была и есть пуста
-        if (table[hash].empty()) {
-            assert(!deleted[hash]);
-
-            if (!is_pos_found) {
-                pos_for_insert = hash;
-            }
-
-            table[pos_for_insert] = key;
-            deleted[pos_for_insert] = false;
-            current_size++;
+// Проверка снимков: сохранение и чтение, отказ на обрезанном файле и на
+// подобранном заголовке, размеры из которого переполняют uint64_t, ошибка
+// поиска по ссылке на ключ за пределами файла.
+// Возвращает количество непройденных проверок
+int Test() {
+    int n_failed = 0;
+    auto check = [&n_failed](bool is_passed, const char *name) {
+        std::cout << name << (is_passed ? " - ok" : " - FAILED") << '\n';
+        n_failed += !is_passed;
+    };
+
+    HashTable table(8, 5, true);
+    for (int i = 0; i < 1000; i++) {
+        table.Add("key" + std::to_string(i));
+    }
+    for (int i = 0; i < 1000; i += 3) {
+        table.Remove("key" + std::to_string(i));
+    }
+    HashTableSnapshot::Save(table, snapshot_test_path);
 
-            if (current_size / table.size() >= max_fill_coef) {
-                Rehash();
-            }
-            return true;
-        }
+    std::ifstream temp_file(std::string(snapshot_test_path) + ".tmp");
+    check(!temp_file, "Save leaves no temporary file");
 
-        // Сейчас в этой ячейке текущий ключ
-        if ((table[hash] == key) && (!deleted[hash])) {
-            return false;
+    {
+        HashTableSnapshot snapshot(snapshot_test_path);
+        bool is_equal = (snapshot.Size() == table.Size());
+        for (int i = 0; i < 2000; i++) {
+            const std::string key = "key" + std::to_string(i);
+            is_equal = is_equal && (snapshot.Has(key) == table.Has(key));
         }
-
-        // Раньше в этой ячейке был какой-то ключ
-        if (deleted[hash]) {
-            if (!is_pos_found) {
-                pos_for_insert = hash;
-                is_pos_found = true;
-            }
-        }
-        hash = GetNewHash(hash, i);
+        check(is_equal, "Snapshot matches table");
     }
 
-    throw overflow_error("");
+    const std::string saved = ReadTestFile(snapshot_test_path);
+    check(IsSnapshotRejected(saved.substr(0, saved.size() - 1)),
+          "Truncated snapshot is rejected");
+
+    // Ссылки на ключи (offset, length) лежат после заголовка (40 байт),
+    // управляющих байтов и хэшей ячеек; offset всех ключей портится
+    uint64_t saved_slot_count = 0;
+    std::memcpy(&saved_slot_count, &saved[16], sizeof(saved_slot_count));
+    std::string corrupt = saved;
+    const uint64_t bad_offset = UINT64_MAX - 1;
+    for (uint64_t i = 0; i < saved_slot_count; i++) {
+        std::memcpy(&corrupt[40 + 9 * saved_slot_count + 16 * i],
+                    &bad_offset, sizeof(bad_offset));
+    }
+    WriteTestFile(snapshot_test_path, corrupt);
+    bool is_thrown = false;
+    try {
+        HashTableSnapshot snapshot(snapshot_test_path);
+        snapshot.Has("key1");
+    } catch (const std::runtime_error &) {
+        is_thrown = true;
+    }
+    check(is_thrown, "Key outside of the file is not read");
+
+    // Заголовок: magic, version, random_value, slot_count, size, blob_size.
+    // slot_count * 25 + blob_size по модулю 2^64 равно размеру ячеек и
+    // ключей в файле, хотя ячеек в файле нет
+    const uint64_t file_size = 4096;
+    const uint64_t header_size = 40;
+    const uint64_t slot_count = static_cast<uint64_t>(1) << 60;
+    const uint64_t blob_size = file_size - header_size - slot_count * 25;
+    std::string crafted(file_size, '\0');
+    const uint32_t version = 1;
+    const int32_t random_value = 5;
+    const uint64_t size = 0;
+    std::memcpy(&crafted[0], "HT81SNAP", 8);
+    std::memcpy(&crafted[8], &version, sizeof(version));
+    std::memcpy(&crafted[12], &random_value, sizeof(random_value));
+    std::memcpy(&crafted[16], &slot_count, sizeof(slot_count));
+    std::memcpy(&crafted[24], &size, sizeof(size));
+    std::memcpy(&crafted[32], &blob_size, sizeof(blob_size));
+    check(IsSnapshotRejected(crafted), "Overflowing header is rejected");
+
+    std::remove(snapshot_test_path);
+    return n_failed;
 }
 
 
-// Среднее время работы: O(1)
-bool HashTable::Remove(const string &key) {
-    size_t hash = GetBaseHash(key);
+// Выполнить команды из stdin над множеством table
+// Время работы: O(n), где n - количество операций со множеством
+template<typename TSet>
+void RunCommands(TSet &table) {
+    FastInput input;
+    FastOutput output;
+
+    // Команды выполняются пакетами с предвыборкой ячеек таблицы
+    SetCommandEngine<TSet> engine(table);
+    engine.Run(input, output);
+}
 
-    for (size_t i = 0; i < table.size(); i++) {
-        // Ячейка была и есть пуста
-        if (table[hash].empty()) {
-            assert(!deleted[hash]);
-            return false;
-        }
 
-        // Сейчас в этой ячейке текущий ключ
-        if ((table[hash] == key) && (!deleted[hash])) {
-            deleted[hash] = true;
-            return true;
+// Параметры командной строки:
+// --filter - проверять ключи фильтром Блума перед таблицей
+// (FilteredHashTable), выгодно, когда большинство запросов - к отсутствующим
+// ключам
+// --test - выполнить проверки снимков (Test) вместо решения задачи
+int main(int argc, char *argv[]) {
+    bool is_filtered = false;
+    for (int i = 1; i < argc; i++) {
+        const std::string option = argv[i];
+        if (option == "--filter") {
+            is_filtered = true;
+        } else if (option == "--test") {
+            return (Test() == 0) ? 0 : 1;
+        } else {
+            std::cerr << "Unknown option: " << option << '\n';
+            return 1;
         }
-
-        // Раньше в этой ячейке был текущий ключ
-        if ((table[hash] == key) && (deleted[hash])) {
-            return false;
-        }
-        hash = GetNewHash(hash, i);
     }
 
-    throw overflow_error("");
-}
-
-
-int main() {
-    HashTable table(8, 5);
-    char command = ' ';
-    string value;
-
-    while (cin >> command >> value) {
-        switch (command) {
-            case '?':
-                cout << (table.Has(value) ? "OK" : "FAIL") << endl;
-                break;
-            case '+':
-                cout << (table.Add(value) ? "OK" : "FAIL") << endl;
-                break;
-            case '-':
-                cout << (table.Remove(value) ? "OK" : "FAIL") << endl;
-                break;
-            default:
-                cout << "FAIL" << endl;
-        }
+    if (is_filtered) {
+        FilteredHashTable table(8, 5);
+        RunCommands(table);
+    } else {
+        HashTable table(8, 5);
+        RunCommands(table);
     }
 
     return 0;
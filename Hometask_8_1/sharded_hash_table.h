@@ -0,0 +1,210 @@
+// Потокобезопасное множество строк: ключи распределены по хэшу между
+// независимыми хэш-таблицами (шардами), у каждой из которых своя блокировка.
+// Потоки, работающие с разными шардами, не мешают друг другу.
+//
+// Пакетный метод Execute группирует команды по шардам и захватывает
+// блокировку каждого шарда один раз на пакет. Внутри шарда команды
+// выполняются в исходном порядке, а команды с разными ключами в разных шардах
+// независимы, поэтому результат совпадает с последовательным выполнением
+// пакета.
+
+
+#ifndef HOMETASK_8_1_SHARDED_HASH_TABLE_H
+#define HOMETASK_8_1_SHARDED_HASH_TABLE_H
+
+
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hash_table.h"
+
+
+class ShardedHashTable {
+private:
+    // Шард выбирается по битам хэша, начиная с shard_shift: младшие биты
+    // использует сама таблица (фрагмент и номер группы)
+    static const int shard_shift = 40;
+
+    // Шарды выделяются в куче по отдельности, чтобы таблица не требовала
+    // конструктора перемещения
+    struct Shard {
+        std::mutex lock;
+        HashTable table;
+
+        Shard(size_t initial_size, int random_value);
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    // Количество шардов - степень двойки, shard_mask = количество - 1
+    size_t shard_mask;
+
+    size_t GetShard(size_t hash) const;
+
+public:
+    // Команда над множеством: type - '+', '-' или '?'
+    struct Command {
+        char type;
+        std::string key;
+    };
+
+    // n_shards округляется вверх до степени двойки, initial_size и
+    // random_value - параметры таблицы каждого шарда
+    ShardedHashTable(size_t n_shards, size_t initial_size, int random_value);
+
+    // Констурктор копирования
+    ShardedHashTable(const ShardedHashTable &) = delete;
+
+    // Конструктор перемещения
+    ShardedHashTable(ShardedHashTable &&) = delete;
+
+    // Оператор присваивания копированием
+    ShardedHashTable &operator=(const ShardedHashTable &) = delete;
+
+    // Оператор присваивания перемещением
+    ShardedHashTable &operator=(ShardedHashTable &&) = delete;
+
+    bool Has(const std::string &key);
+
+    bool Add(const std::string &key);
+
+    bool Remove(const std::string &key);
+
+    // Выполнить команды пакета, results[i] - успешность i-й команды (true -
+    // "OK", false - "FAIL")
+    void Execute(const std::vector<Command> &commands,
+                 std::vector<bool> &results);
+
+    // Количество ключей во всех шардах
+    size_t Size();
+};
+
+
+inline ShardedHashTable::Shard::Shard(size_t initial_size, int random_value)
+        : table(initial_size, random_value) {}
+
+
+inline ShardedHashTable::ShardedHashTable(size_t n_shards,
+                                          size_t initial_size,
+                                          int random_value) : shard_mask(0) {
+    assert(n_shards > 0);
+
+    size_t size = 1;
+    while (size < n_shards) {
+        size *= 2;
+    }
+
+    shards.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        shards.emplace_back(new Shard(initial_size, random_value));
+    }
+    shard_mask = size - 1;
+}
+
+
+// Время работы: O(1)
+inline size_t ShardedHashTable::GetShard(size_t hash) const {
+    return (hash >> shard_shift) & shard_mask;
+}
+
+
+// Среднее время работы: O(1) + ожидание блокировки
+inline bool ShardedHashTable::Has(const std::string &key) {
+    // Хэш-функция у всех шардов одинаковая
+    const size_t hash = shards[0]->table.GetBaseHash(key);
+    Shard &shard = *shards[GetShard(hash)];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.Has(key, hash);
+}
+
+
+// Среднее время работы: O(1) + ожидание блокировки
+inline bool ShardedHashTable::Add(const std::string &key) {
+    const size_t hash = shards[0]->table.GetBaseHash(key);
+    Shard &shard = *shards[GetShard(hash)];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.Add(key, hash);
+}
+
+
+// Среднее время работы: O(1) + ожидание блокировки
+inline bool ShardedHashTable::Remove(const std::string &key) {
+    const size_t hash = shards[0]->table.GetBaseHash(key);
+    Shard &shard = *shards[GetShard(hash)];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    return shard.table.Remove(key, hash);
+}
+
+
+// Среднее время работы: O(commands.size() + количество шардов) + ожидание
+// блокировок
+inline void ShardedHashTable::Execute(const std::vector<Command> &commands,
+                                      std::vector<bool> &results) {
+    const size_t n = commands.size();
+    results.assign(n, false);
+
+    // Хэши команд вычисляются без блокировок
+    std::vector<size_t> hashes(n);
+    // offsets[s]..offsets[s + 1] - команды шарда s в векторе order
+    std::vector<size_t> offsets(shards.size() + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        hashes[i] = shards[0]->table.GetBaseHash(commands[i].key);
+        offsets[GetShard(hashes[i]) + 1]++;
+    }
+    for (size_t s = 0; s < shards.size(); s++) {
+        offsets[s + 1] += offsets[s];
+    }
+
+    // Сортировка подсчетом сохраняет порядок команд внутри шарда
+    std::vector<size_t> order(n);
+    std::vector<size_t> next_pos(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        order[next_pos[GetShard(hashes[i])]++] = i;
+    }
+
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (offsets[s] == offsets[s + 1]) {
+            continue;
+        }
+
+        Shard &shard = *shards[s];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        for (size_t j = offsets[s]; j < offsets[s + 1]; j++) {
+            const size_t i = order[j];
+            const Command &command = commands[i];
+            switch (command.type) {
+                case '?':
+                    results[i] = shard.table.Has(command.key, hashes[i]);
+                    break;
+                case '+':
+                    results[i] = shard.table.Add(command.key, hashes[i]);
+                    break;
+                case '-':
+                    results[i] = shard.table.Remove(command.key, hashes[i]);
+                    break;
+                default:
+                    results[i] = false;
+            }
+        }
+    }
+}
+
+
+// Время работы: O(количество шардов) + ожидание блокировок
+inline size_t ShardedHashTable::Size() {
+    size_t size = 0;
+    for (const std::unique_ptr<Shard> &shard : shards) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+        size += shard->table.Size();
+    }
+
+    return size;
+}
+
+
+#endif //HOMETASK_8_1_SHARDED_HASH_TABLE_H
@@ -0,0 +1,185 @@
+// Бенчмарки очереди на односвязном списке и передачи элементов между потоками
+// через очереди: неблокирующие SpscQueue и MpmcQueue и очередь на односвязном
+// списке под мьютексом.
+//
+// В многопоточных бенчмарках потоки с четными номерами добавляют элементы,
+// с нечетными - извлекают, каждый поток выполняет n операций за итерацию.
+
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.h"
+#include "concurrent_queue.h"
+#include "queue.h"
+
+
+using std::lock_guard;
+using std::mutex;
+using std::unique_ptr;
+using std::vector;
+
+
+// Размер буфера неблокирующих очередей
+static const size_t queue_capacity = 1024;
+
+static unique_ptr<SpscQueue<int>> spsc_queue;
+static unique_ptr<MpmcQueue<int>> mpmc_queue;
+static unique_ptr<Queue> locked_queue;
+static mutex locked_queue_mutex;
+
+
+// Все элементы добавляются, затем все извлекаются, и так rounds раз: со
+// второго раза узлы берутся из списка свободных узлов пула
+static void BM_QueuePushThenPop(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const int rounds = 4;
+    const vector<int> values = GenerateRandomInts(n, 0, 1000000000);
+
+    for (auto _ : state) {
+        Queue queue;
+        for (int round = 0; round < rounds; round++) {
+            for (int value : values) {
+                queue.Push(value);
+            }
+            while (!queue.Empty()) {
+                benchmark::DoNotOptimize(queue.Pop());
+            }
+        }
+    }
+    ReportCounters(state, 2 * rounds * static_cast<int64_t>(n));
+}
+BENCHMARK(BM_QueuePushThenPop)->Apply(ScaleArguments);
+
+
+// Количество потоков: 2, 4, ..., не меньше 2 и не больше удвоенного числа
+// ядер (поровну производителей и потребителей)
+static void ThreadPairArguments(benchmark::internal::Benchmark *b) {
+    const int max_threads = std::max(
+            2, 2 * static_cast<int>(std::thread::hardware_concurrency()));
+    for (int threads = 2; threads <= max_threads; threads *= 2) {
+        b->Threads(threads);
+    }
+}
+
+
+static void SetupSpscQueue(const benchmark::State &) {
+    spsc_queue.reset(new SpscQueue<int>(queue_capacity));
+}
+
+
+static void TeardownSpscQueue(const benchmark::State &) {
+    spsc_queue.reset();
+}
+
+
+// Один производитель и один потребитель
+static void BM_SpscQueue(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool is_producer = state.thread_index() == 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; i++) {
+            if (is_producer) {
+                spsc_queue->Push(i);
+            } else {
+                benchmark::DoNotOptimize(spsc_queue->Pop());
+            }
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_SpscQueue)
+        ->Apply(ScaleArguments)
+        ->Threads(2)
+        ->Setup(SetupSpscQueue)
+        ->Teardown(TeardownSpscQueue)
+        ->UseRealTime();
+
+
+static void SetupMpmcQueue(const benchmark::State &) {
+    mpmc_queue.reset(new MpmcQueue<int>(queue_capacity));
+}
+
+
+static void TeardownMpmcQueue(const benchmark::State &) {
+    mpmc_queue.reset();
+}
+
+
+static void BM_MpmcQueue(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool is_producer = state.thread_index() % 2 == 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; i++) {
+            if (is_producer) {
+                mpmc_queue->Push(i);
+            } else {
+                benchmark::DoNotOptimize(mpmc_queue->Pop());
+            }
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_MpmcQueue)
+        ->Apply(ScaleArguments)
+        ->Apply(ThreadPairArguments)
+        ->Setup(SetupMpmcQueue)
+        ->Teardown(TeardownMpmcQueue)
+        ->UseRealTime();
+
+
+static void SetupLockedQueue(const benchmark::State &) {
+    locked_queue.reset(new Queue());
+}
+
+
+static void TeardownLockedQueue(const benchmark::State &) {
+    locked_queue.reset();
+}
+
+
+// Извлечь элемент из очереди под мьютексом, дождавшись его
+static int PopLocked() {
+    while (true) {
+        {
+            lock_guard<mutex> guard(locked_queue_mutex);
+            if (!locked_queue->Empty()) {
+                return locked_queue->Pop();
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+
+// Очередь на односвязном списке под одним мьютексом (узлы из пула очереди)
+static void BM_LockedQueue(benchmark::State &state) {
+    const int n = static_cast<int>(state.range(0));
+    const bool is_producer = state.thread_index() % 2 == 0;
+
+    for (auto _ : state) {
+        for (int i = 0; i < n; i++) {
+            if (is_producer) {
+                lock_guard<mutex> guard(locked_queue_mutex);
+                locked_queue->Push(i);
+            } else {
+                benchmark::DoNotOptimize(PopLocked());
+            }
+        }
+    }
+    ReportCounters(state, n);
+}
+BENCHMARK(BM_LockedQueue)
+        ->Apply(ScaleArguments)
+        ->Apply(ThreadPairArguments)
+        ->Setup(SetupLockedQueue)
+        ->Teardown(TeardownLockedQueue)
+        ->UseRealTime();
+
+
+BENCHMARK_MAIN();
@@ -1,115 +1,71 @@
-#include <cassert>
-#include <iostream>
-
-
-using std::cin;
-using std::cout;
-
-
-// Узел односвязного списка
-struct QueueNode {
-    int value;
-    QueueNode *next;
-
-    QueueNode(int val, QueueNode *ptr) : value(val), next(ptr) {}
-};
-
-
-class Queue {
-private:
-    QueueNode *head;
-    QueueNode *tail;
-
-public:
-    Queue() : head(nullptr), tail(nullptr) {}
-
-    ~Queue();
+// Команды разбираются в отдельном потоке и выполняются пакетами
+// (command_pipeline.h). Если на вход подана двоичная трасса команд
+// (command_trace.h, записывается Tools/trace_converter), команды выполняются
+// прямо из отображенного в память файла без разбора.
 
-    // Проверка очереди на пустоту
-    bool Empty() const;
-
-    // Добавление элемента
-    void Push(int value);
-
-    // Извелечение
-    int Pop();
-};
-
-
-Queue::~Queue() {
-    while (head) {
-        QueueNode *temp = head->next;
-        delete head;
-        head = temp;
-
-//        // Альтернативный вариант:
-//        QueueNode *to_delete = head;
-//        head = head->next;
-//        delete to_delete;
-    }
-}
 
+#include <iostream>
+#include <stdexcept>
 
-bool Queue::Empty() const {
-    assert((head == nullptr) == (tail == nullptr));
+#include "command_pipeline.h"
+#include "command_trace.h"
+#include "fast_input.h"
+#include "queue.h"
 
-    return head == nullptr;
-}
-
-
-void Queue::Push(int value) {
-    if (Empty()) {
-        head = tail = new QueueNode{value, nullptr};
-    } else {
-        tail->next = new QueueNode{value, nullptr};
-        tail = tail->next;
-    }
-}
 
+using std::cout;
 
-int Queue::Pop() {
-    assert(!Empty());
-    int result = head->value;
 
-    if (head == tail) {
-        // Остался один элемент
-        delete head;
-        head = tail = nullptr;
-    } else {
-        QueueNode *temp = head->next;
-        delete head;
-        head = temp;
+// Выполнить count команд над очередью, false - если ожидаемое значение не
+// совпало (команды, кроме 2 и 3, пропускаются)
+// Время работы: O(count)
+bool ExecuteCommands(Queue &queue, const QueueCommand *commands,
+                     size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        const int value = commands[i].value;
+        if (commands[i].command == 3) {
+            queue.Push(value);
+        } else if (commands[i].command == 2) {
+            if (queue.Empty()) {
+                if (value != -1) {
+                    return false;
+                }
+            } else if (queue.Pop() != value) {
+                return false;
+            }
+        }
     }
 
-    return result;
+    return true;
 }
 
 
 int main() {
-    int n = 0;
-    cin >> n;
-
     Queue queue;
-    for (int i = 0; i < n; ++i) {
-        int command = 0;
-        int value = 0;
-        cin >> command >> value;
-
-        if (command == 3) {
-            queue.Push(value);
-        } else if (command == 2) {
-            if (queue.Empty()) {
-                if (value != -1) {
-                    cout << "NO";
-                    return 0;
-                }
-            } else if (queue.Pop() != value) {
-                cout << "NO";
-                return 0;
-            }
+    bool is_correct = true;
+
+    if (CommandTrace::IsTrace(STDIN_FILENO)) {
+        // Файл начинается с заголовка трассы, но может быть обрезан или
+        // поврежден
+        try {
+            const CommandTrace trace(STDIN_FILENO);
+            is_correct = ExecuteCommands(queue, trace.Commands(),
+                                         trace.Size());
+        } catch (const std::runtime_error &error) {
+            std::cerr << error.what() << '\n';
+            return 1;
         }
+    } else {
+        FastInput input;
+        int n = 0;
+        input.ReadInt(n);
+
+        is_correct = RunCommandPipeline(
+                input, n, [&queue](const QueueCommand *commands, size_t count) {
+                    return ExecuteCommands(queue, commands, count);
+                });
     }
-    cout << "YES";
+    cout << (is_correct ? "YES" : "NO");
 
     return 0;
 }
@@ -0,0 +1,81 @@
+// Очередь на односвязном списке.
+//
+// Узлы выделяются из пула (NodePool): извлеченные узлы переиспользуются при
+// следующих добавлениях, а при разрушении очереди пул освобождает блоки узлов
+// целиком.
+
+
+#ifndef LESSON_1_QUEUE_H
+#define LESSON_1_QUEUE_H
+
+
+#include <cassert>
+
+#include "node_pool.h"
+
+
+// Узел односвязного списка
+struct QueueNode {
+    int value;
+    QueueNode *next;
+
+    QueueNode(int val, QueueNode *ptr) : value(val), next(ptr) {}
+};
+
+
+class Queue {
+private:
+    NodePool<QueueNode> pool;
+    QueueNode *head;
+    QueueNode *tail;
+
+public:
+    Queue() : head(nullptr), tail(nullptr) {}
+
+    // Проверка очереди на пустоту
+    bool Empty() const;
+
+    // Добавление элемента
+    void Push(int value);
+
+    // Извелечение
+    int Pop();
+};
+
+
+inline bool Queue::Empty() const {
+    assert((head == nullptr) == (tail == nullptr));
+
+    return head == nullptr;
+}
+
+
+inline void Queue::Push(int value) {
+    if (Empty()) {
+        head = tail = pool.New(value, nullptr);
+    } else {
+        tail->next = pool.New(value, nullptr);
+        tail = tail->next;
+    }
+}
+
+
+inline int Queue::Pop() {
+    assert(!Empty());
+    int result = head->value;
+
+    if (head == tail) {
+        // Остался один элемент
+        pool.Delete(head);
+        head = tail = nullptr;
+    } else {
+        QueueNode *temp = head->next;
+        pool.Delete(head);
+        head = temp;
+    }
+
+    return result;
+}
+
+
+#endif //LESSON_1_QUEUE_H
@@ -1,35 +1,65 @@
 #include <cassert>
-#include <iostream>
 #include <string>
 #include <vector>
 
+#include "fast_input.h"
+#include "fast_output.h"
+#include "node_pool.h"
+#include "set_command_engine.h"
+#include "string_arena.h"
+#include "string_hash.h"
+
 
-using std::cin;
-using std::cout;
-using std::endl;
 using std::move;
 using std::string;
 using std::vector;
 
 
+// Хэш-таблица с цепочками. Размер таблицы - степень двойки, при заполнении
+// таблица увеличивается в 2 раза. Перехэширование выполняется постепенно:
+// каждая операция Add и Remove переносит в новую таблицу несколько цепочек,
+// поэтому ни одна операция не тратит время на перенос всей таблицы.
 class HashTable {
 private:
     struct HashTableNode {
-        string key;
+        // Ключ хранится в арене
+        StringRef key;
+        // Хэш ключа, чтобы не вычислять его при перехэшировании
+        size_t hash;
         HashTableNode *next = nullptr;
 
-        explicit HashTableNode(string key_) : key(move(key_)) {}
+        HashTableNode(StringRef key_, size_t hash_) : key(key_), hash(hash_) {}
     };
 
+    // Количество цепочек, переносимых за одну операцию
+    static const size_t rehash_step = 4;
+
     vector<HashTableNode *> table;
+    // Новая таблица в 2 раза больше (не пуста только во время
+    // перехэширования). Цепочки table с номерами меньше rehash_pos уже
+    // перенесены в new_table
+    vector<HashTableNode *> new_table;
+    size_t rehash_pos = 0;
+    const float max_load_factor;
+    size_t size = 0;
+    StringArena arena;
+    NodePool<HashTableNode> pool;
+
+    // Голова цепочки, в которой находится или должен находиться ключ с хэшем
+    // hash
+    HashTableNode *const &GetChain(size_t hash) const;
+
+    HashTableNode *&GetChain(size_t hash);
 
-    size_t GetHash(const string &key) const;
+    // Перенести в новую таблицу очередные rehash_step цепочек
+    void RehashStep();
+
+    // Переложить ключи в новую арену, если в старой много удаленных строк
+    void CompactArena();
 
 public:
     explicit HashTable(size_t initial_size);
 
-    ~HashTable();
-
     // Констурктор копирования
     HashTable(const HashTable &) = delete;
 
@@ -47,35 +77,120 @@ public:
     bool Add(const string &key);
 
     bool Remove(const string &key);
+
+    // Хэш всей строки
+    static size_t GetBaseHash(const string &key);
+
+    // Операции с уже вычисленным хэшем hash = GetBaseHash(key)
+    bool Has(const string &key, size_t hash) const;
+
+    bool Add(const string &key, size_t hash);
+
+    bool Remove(const string &key, size_t hash);
+
+    // Предвыборка в кэш головы цепочки для хэша hash (перед пакетом операций)
+    void Prefetch(size_t hash) const;
 };
 
 
-// Создается вектор размера initial_size, все значения равны nullptr
-HashTable::HashTable(size_t initial_size) : table(initial_size, nullptr) {}
+// Размер таблицы - наименьшая степень двойки, не меньшая initial_size.
+// Память узлов и ключей освобождается вместе с пулом и ареной
+HashTable::HashTable(size_t initial_size) : max_load_factor(1) {
+    size_t table_size = 1;
+    while (table_size < initial_size) {
+        table_size *= 2;
+    }
+    table.assign(table_size, nullptr);
+}
+
+
+// Хэш всей строки: символы обрабатываются по 8 за раз
+size_t HashTable::GetBaseHash(const string &key) {
+    assert(!key.empty());
+
+    return GetStringHash(key.data(), key.size());
+}
+
+
+HashTable::HashTableNode *const &HashTable::GetChain(size_t hash) const {
+    const size_t pos = hash & (table.size() - 1);
+    if (pos < rehash_pos) {
+        return new_table[hash & (new_table.size() - 1)];
+    }
+
+    return table[pos];
+}
 
 
-HashTable::~HashTable() {
-    for (HashTableNode *head : table) {
+HashTable::HashTableNode *&HashTable::GetChain(size_t hash) {
+    return const_cast<HashTableNode *&>(
+            static_cast<const HashTable *>(this)->GetChain(hash));
+}
+
+
+void HashTable::RehashStep() {
+    if (new_table.empty()) {
+        return;
+    }
+
+    const size_t new_mask = new_table.size() - 1;
+    for (size_t i = 0; (i < rehash_step) && (rehash_pos < table.size());
+         i++, rehash_pos++) {
+        HashTableNode *head = table[rehash_pos];
         while (head) {
             HashTableNode *next = head->next;
-            delete head;
+            head->next = new_table[head->hash & new_mask];
+            new_table[head->hash & new_mask] = head;
             head = next;
         }
+        table[rehash_pos] = nullptr;
+    }
+
+    // Все цепочки перенесены
+    if (rehash_pos == table.size()) {
+        table.swap(new_table);
+        vector<HashTableNode *>().swap(new_table);
+        rehash_pos = 0;
     }
 }
 
 
-size_t HashTable::GetHash(const string &key) const {
-    assert(!key.empty());
+void HashTable::CompactArena() {
+    if (!arena.IsCompactionNeeded()) {
+        return;
+    }
 
-    return key[0] % table.size();
+    StringArena new_arena;
+    for (const vector<HashTableNode *> *chains : {&table, &new_table}) {
+        for (HashTableNode *head : *chains) {
+            for (; head != nullptr; head = head->next) {
+                head->key = arena.CopyTo(head->key, new_arena);
+            }
+        }
+    }
+    arena = move(new_arena);
 }
 
 
 bool HashTable::Has(const string &key) const {
-    const size_t hash = GetHash(key);
-    for (auto head = table[hash]; head != nullptr; head = head->next) {
-        if (head->key == key) {
+    return Has(key, GetBaseHash(key));
+}
+
+
+bool HashTable::Add(const string &key) {
+    return Add(key, GetBaseHash(key));
+}
+
+
+bool HashTable::Remove(const string &key) {
+    return Remove(key, GetBaseHash(key));
+}
+
+
+bool HashTable::Has(const string &key, size_t hash) const {
+    assert(hash == GetBaseHash(key));
+    for (auto head = GetChain(hash); head != nullptr; head = head->next) {
+        if ((head->hash == hash) && arena.IsEqual(head->key, key)) {
             return true;
         }
     }
@@ -84,42 +199,44 @@ bool HashTable::Has(const string &key) const {
 }
 
 
-bool HashTable::Add(const string &key) {
-    const size_t hash = GetHash(key);
-    for (auto head = table[hash]; head != nullptr; head = head->next) {
-        if (head->key == key) {
+bool HashTable::Add(const string &key, size_t hash) {
+    assert(hash == GetBaseHash(key));
+    RehashStep();
+
+    HashTableNode *&chain = GetChain(hash);
+    for (auto head = chain; head != nullptr; head = head->next) {
+        if ((head->hash == hash) && arena.IsEqual(head->key, key)) {
             return false;
         }
     }
-    auto *new_node = new HashTableNode(key);
-    new_node->next = table[hash];
-    table[hash] = new_node;
+    HashTableNode *new_node = pool.New(arena.Add(key), hash);
+    new_node->next = chain;
+    chain = new_node;
+    size++;
+
+    // Начинаем перехэширование в таблицу в 2 раза больше
+    if (new_table.empty() && (size > max_load_factor * table.size())) {
+        new_table.assign(table.size() * 2, nullptr);
+        rehash_pos = 0;
+    }
 
     return true;
 }
 
 
-bool HashTable::Remove(const string &key) {
-    const size_t hash = GetHash(key);
-    HashTableNode *&head = table[hash];
-
-    if (!head) {
-        return false;
-    }
-
-    if (head->key == key) {
-        HashTableNode *to_delete = head;
-        head = head->next;
-        delete to_delete;
-        return true;
-    }
+bool HashTable::Remove(const string &key, size_t hash) {
+    assert(hash == GetBaseHash(key));
+    RehashStep();
 
-    HashTableNode *parent = head;
-    for (; parent->next != nullptr; parent = parent->next) {
-        if (parent->next->key == key) {
-            HashTableNode *to_delete = parent->next;
-            parent->next = parent->next->next;
-            delete to_delete;
+    HashTableNode **parent_next = &GetChain(hash);
+    for (; *parent_next != nullptr; parent_next = &(*parent_next)->next) {
+        HashTableNode *node = *parent_next;
+        if ((node->hash == hash) && arena.IsEqual(node->key, key)) {
+            *parent_next = node->next;
+            arena.Release(node->key);
+            pool.Delete(node);
+            size--;
+            CompactArena();
             return true;
         }
     }
@@ -128,26 +245,19 @@ bool HashTable::Remove(const string &key) {
 }
 
 
+void HashTable::Prefetch(size_t hash) const {
+    __builtin_prefetch(&GetChain(hash));
+}
+
+
 int main() {
+    FastInput input;
+    FastOutput output;
     HashTable table(100);
-    char command = ' ';
-    string value = " ";
-
-    while (cin >> command >> value) {
-        switch (command) {
-            case '?':
-                cout << (table.Has(value) ? "OK" : "FAIL") << endl;
-                break;
-            case '+':
-                cout << (table.Add(value) ? "OK" : "FAIL") << endl;
-                break;
-            case '-':
-                cout << (table.Remove(value) ? "OK" : "FAIL") << endl;
-                break;
-            default:
-                cout << "FAIL" << endl;
-        }
-    }
+
+    // Команды выполняются пакетами с предвыборкой цепочек
+    SetCommandEngine<HashTable> engine(table);
+    engine.Run(input, output);
 
     return 0;
 }
@@ -0,0 +1,75 @@
+#!/usr/bin/env bash
+# Сравнение времени работы задач в нескольких сборках на одних и тех же
+# входных данных.
+#
+# Использование: compare_builds.sh [-n n] [-r повторы] <директория сборки>...
+#
+# Пример (Release, LTO и PGO):
+#   cmake -S . -B build/release
+#   cmake -S . -B build/lto -DENABLE_LTO=ON
+#   cmake -S . -B build/pgo-generate -DPGO=GENERATE
+#   cmake --build build/pgo-generate && cmake --build build/pgo-generate \
+#       --target pgo_train
+#   cmake -S . -B build/pgo -DPGO=USE \
+#       -DPGO_PROFILE_DIR=$PWD/build/pgo-generate/pgo-profile
+#   cmake --build build/release && cmake --build build/lto && \
+#       cmake --build build/pgo
+#   Tools/compare_builds.sh build/release build/lto build/pgo
+
+set -euo pipefail
+
+scale=1000000
+repeats=3
+while getopts "n:r:" option; do
+    case $option in
+        n) scale=$OPTARG ;;
+        r) repeats=$OPTARG ;;
+        *) exit 1 ;;
+    esac
+done
+shift $((OPTIND - 1))
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 [-n n] [-r repeats] <build dir>..." >&2
+    exit 1
+fi
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+# Входные данные генерируются первой сборкой и общие для всех сборок
+input_dir="$1/workload-inputs"
+results_dir=$(mktemp -d)
+trap 'rm -rf "$results_dir"' EXIT
+
+for ((i = 1; i <= $#; i++)); do
+    echo "Running ${!i}..." >&2
+    "$script_dir/run_workloads.sh" "${!i}" "$input_dir" "$scale" \
+        "$repeats" > "$results_dir/$i" || true
+done
+
+# Таблица: строка - задача, столбец - сборка
+printf "%-16s" "task"
+for build in "$@"; do
+    printf " %14s" "$(basename "$build")"
+done
+printf "\n"
+
+awk -v n_builds=$# '
+    {
+        if (!($1 in seen)) {
+            seen[$1] = 1
+            order[n_tasks++] = $1
+        }
+        time[$1, FILENAME] = $2
+    }
+    END {
+        for (t = 0; t < n_tasks; t++) {
+            printf "%-16s", order[t]
+            for (b = 1; b <= n_builds; b++) {
+                file = dir "/" b
+                value = ((order[t], file) in time) ? time[order[t], file] : "-"
+                printf " %14s", value
+            }
+            printf "\n"
+        }
+    }' dir="$results_dir" $(for ((i = 1; i <= $#; i++)); do
+                                echo "$results_dir/$i"; done)
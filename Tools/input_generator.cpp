@@ -0,0 +1,285 @@
+// Генератор входных данных для задач.
+//
+// Использование: input_generator <задача> <n> [seed]
+// Печатает в stdout корректные входные данные задачи размера порядка n в
+// формате из ее условия. Данные детерминированы (зависят только от n и seed,
+// но не от стандартной библиотеки, см. portable_random.h), поэтому на них
+// можно обучать PGO-сборку и сравнивать время работы разных сборок.
+
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "portable_random.h"
+
+
+using std::cerr;
+using std::cout;
+using std::deque;
+using std::ostream;
+using std::string;
+using std::vector;
+
+
+typedef std::mt19937_64 Generator;
+
+
+// Seed по умолчанию (совпадает с seed бенчмарков)
+const uint64_t default_seed = 20200214;
+
+
+// Случайное целое число из [min_value, max_value]
+// Время работы: O(1)
+int64_t RandomInt(Generator &generator, int64_t min_value, int64_t max_value) {
+    return RandomInRange(generator, min_value, max_value);
+}
+
+
+// Случайная строка длины из [min_length, max_length] из букв 'a'..max_letter
+// Время работы: O(max_length)
+string RandomString(Generator &generator, int min_length, int max_length,
+                    char max_letter) {
+    string str(RandomInt(generator, min_length, max_length), ' ');
+    for (char &ch : str) {
+        ch = static_cast<char>(RandomInt(generator, 'a', max_letter));
+    }
+
+    return str;
+}
+
+
+// Команды очереди (2 - извлечение, 3 - добавление) с верными ожидаемыми
+// значениями, в т.ч. извлечения из пустой очереди
+// Время работы: O(n)
+void GenerateQueueCommands(int n, Generator &generator, ostream &out) {
+    deque<int> queue;
+    out << n << '\n';
+    for (int i = 0; i < n; i++) {
+        if (RandomInt(generator, 0, 9) < 6) {
+            const int value = static_cast<int>(RandomInt(generator, 0,
+                                                         1000000000));
+            queue.push_back(value);
+            out << "3 " << value << '\n';
+        } else if (queue.empty()) {
+            out << "2 -1\n";
+        } else {
+            out << "2 " << queue.front() << '\n';
+            queue.pop_front();
+        }
+    }
+}
+
+
+// Команды дека (1 - добавление в начало, 2 - извлечение из начала,
+// 3 - добавление в конец, 4 - извлечение из конца) с верными ожидаемыми
+// значениями, в т.ч. извлечения из пустого дека
+// Время работы: O(n)
+void GenerateDequeCommands(int n, Generator &generator, ostream &out) {
+    deque<int> values;
+    out << n << '\n';
+    for (int i = 0; i < n; i++) {
+        const bool is_front = RandomInt(generator, 0, 1) == 0;
+        if (RandomInt(generator, 0, 9) < 6) {
+            const int value = static_cast<int>(RandomInt(generator, 0,
+                                                         1000000000));
+            if (is_front) {
+                values.push_front(value);
+                out << "1 " << value << '\n';
+            } else {
+                values.push_back(value);
+                out << "3 " << value << '\n';
+            }
+        } else if (values.empty()) {
+            out << (is_front ? "2 -1\n" : "4 -1\n");
+        } else if (is_front) {
+            out << "2 " << values.front() << '\n';
+            values.pop_front();
+        } else {
+            out << "4 " << values.back() << '\n';
+            values.pop_back();
+        }
+    }
+}
+
+
+// Расписание электричек, упорядоченное по времени прибытия
+// Время работы: O(n)
+void GenerateTrains(int n, Generator &generator, ostream &out) {
+    int64_t train_in = 0;
+    out << n << '\n';
+    for (int i = 0; i < n; i++) {
+        train_in += RandomInt(generator, 0, 3);
+        out << train_in << ' ' << train_in + RandomInt(generator, 0, 1000)
+            << '\n';
+    }
+}
+
+
+// Последовательность чисел без указания количества
+// Время работы: O(n)
+void GenerateSequence(int n, Generator &generator, ostream &out) {
+    for (int i = 0; i < n; i++) {
+        out << RandomInt(generator, -1000000000, 1000000000) << '\n';
+    }
+}
+
+
+// Массив и номер порядковой статистики
+// Время работы: O(n)
+void GenerateOrderStatistics(int n, Generator &generator, ostream &out) {
+    out << n << ' ' << RandomInt(generator, 0, n - 1) << '\n';
+    for (int i = 0; i < n; i++) {
+        out << RandomInt(generator, 0, 1000000000) << '\n';
+    }
+}
+
+
+// Ключи для наивного бинарного дерева поиска
+// Время работы: O(n)
+void GenerateTreeKeys(int n, Generator &generator, ostream &out) {
+    out << n << '\n';
+    for (int i = 0; i < n; i++) {
+        out << RandomInt(generator, INT32_MIN, INT32_MAX) << '\n';
+    }
+}
+
+
+// Операции над множеством строк. Строки выбираются из пула размера n / 4,
+// поэтому среди операций есть и успешные, и неуспешные
+// Время работы: O(n)
+void GenerateStringSetCommands(int n, Generator &generator, ostream &out) {
+    const char commands[] = {'+', '+', '-', '?'};
+
+    vector<string> pool(n / 4 + 1);
+    for (string &str : pool) {
+        str = RandomString(generator, 1, 12, 'z');
+    }
+
+    for (int i = 0; i < n; i++) {
+        out << commands[RandomInt(generator, 0, 3)] << ' '
+            << pool[RandomInt(generator, 0, pool.size() - 1)] << '\n';
+    }
+}
+
+
+// Количество вершин графа с n ребрами, не больше max_V из условия задачи
+// Время работы: O(1)
+int GetGraphVertexCount(int n, int max_V) {
+    return std::min(n / 4 + 2, max_V);
+}
+
+
+// Связный граф из GetGraphVertexCount(n, max_V) вершин и n ребер: случайное
+// дерево и случайные ребра. Вершины нумеруются с first_vertex, вес ребер
+// печатается, если is_weighted
+// Время работы: O(n)
+void GenerateGraphEdges(int n, int max_V, int first_vertex, bool is_weighted,
+                        Generator &generator, ostream &out) {
+    const int V = GetGraphVertexCount(n, max_V);
+    const int E = n;
+    out << V << ' ' << E << '\n';
+    for (int i = 0; i < E; i++) {
+        // Первые V - 1 ребер образуют дерево
+        const int64_t from = (i + 1 < V) ? i + 1 : RandomInt(generator, 0,
+                                                              V - 1);
+        const int64_t to = (i + 1 < V) ? RandomInt(generator, 0, i) :
+                           RandomInt(generator, 0, V - 1);
+        out << from + first_vertex << ' ' << to + first_vertex;
+        if (is_weighted) {
+            out << ' ' << RandomInt(generator, 1, 1000);
+        }
+        out << '\n';
+    }
+}
+
+
+// Граф и пара вершин для подсчета кратчайших путей
+// Время работы: O(n)
+void GenerateShortestPaths(int n, Generator &generator, ostream &out) {
+    const int max_V = 50000;
+    GenerateGraphEdges(n, max_V, 0, false, generator, out);
+    const int V = GetGraphVertexCount(n, max_V);
+    out << RandomInt(generator, 0, V - 1) << ' '
+        << RandomInt(generator, 0, V - 1) << '\n';
+}
+
+
+// Шаблон и строка из двух букв, чтобы вхождений и частичных совпадений было
+// много
+// Время работы: O(n)
+void GenerateSubstringSearch(int n, Generator &generator, ostream &out) {
+    out << RandomString(generator, 8, 8, 'b') << '\n'
+        << RandomString(generator, n, n, 'b') << '\n';
+}
+
+
+// Случайные точки в квадрате [-1000, 1000] x [-1000, 1000]
+// Время работы: O(n)
+void GeneratePoints(int n, Generator &generator, ostream &out) {
+    out << n << '\n' << std::fixed << std::setprecision(4);
+    for (int i = 0; i < n; i++) {
+        // Координаты вычисляются по очереди: порядок вычисления операндов <<
+        // до C++17 не определен
+        const double x = RandomReal(generator, -1000.0, 1000.0);
+        const double y = RandomReal(generator, -1000.0, 1000.0);
+        out << x << ' ' << y << '\n';
+    }
+}
+
+
+int main(int argc, char *argv[]) {
+    if ((argc != 3) && (argc != 4)) {
+        cerr << "Usage: " << argv[0] << " <task> <n> [seed]\n";
+        return 1;
+    }
+
+    const string task = argv[1];
+    const int n = std::atoi(argv[2]);
+    if (n <= 0) {
+        cerr << "n must be positive\n";
+        return 1;
+    }
+    Generator generator((argc == 4) ? std::strtoull(argv[3], nullptr, 10) :
+                        default_seed);
+
+    std::ios::sync_with_stdio(false);
+    if (task == "Hometask_1_3") {
+        GenerateDequeCommands(n, generator, cout);
+    } else if (task == "Lesson_1") {
+        GenerateQueueCommands(n, generator, cout);
+    } else if (task == "Hometask_2_3") {
+        GenerateTrains(n, generator, cout);
+    } else if (task == "Hometask_3_3") {
+        GenerateSequence(n, generator, cout);
+    } else if (task == "Hometask_4_4") {
+        GenerateOrderStatistics(n, generator, cout);
+    } else if (task == "Hometask_6_1") {
+        GenerateTreeKeys(n, generator, cout);
+    } else if ((task == "Hometask_8_1") || (task == "Lesson_4")) {
+        GenerateStringSetCommands(n, generator, cout);
+    } else if (task == "Hometask_11_2") {
+        GenerateShortestPaths(n, generator, cout);
+    } else if (task == "Hometask_12") {
+        // Рекурсивный DFS рассчитан на ограничение V <= 20000 из условия
+        GenerateGraphEdges(n, 20000, 1, false, generator, cout);
+    } else if (task == "Hometask_14_1") {
+        GenerateGraphEdges(n, INT_MAX, 1, true, generator, cout);
+    } else if (task == "Hometask_16_1") {
+        GenerateSubstringSearch(n, generator, cout);
+    } else if (task == "Hometask_18_2") {
+        GeneratePoints(n, generator, cout);
+    } else {
+        cerr << "Unknown task: " << task << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# Запуск всех задач на сгенерированных входных данных.
+#
+# Использование: run_workloads.sh <директория сборки> <директория входных
+# данных> [n] [количество повторов]
+#
+# Входные данные генерируются программой input_generator из директории сборки
+# один раз и переиспользуются при следующих запусках с тем же n. Для каждой
+# задачи печатается минимальное по повторам время работы в секундах ("-", если
+# задача завершилась с ошибкой).
+
+set -euo pipefail
+
+if [ $# -lt 2 ]; then
+    echo "Usage: $0 <build dir> <input dir> [n] [repeats]" >&2
+    exit 1
+fi
+
+build_dir=$(cd "$1" && pwd)
+mkdir -p "$2"
+input_dir=$(cd "$2" && pwd)
+scale=${3:-1000000}
+repeats=${4:-3}
+
+# Задачи, у которых есть входные данные
+tasks="Hometask_1_3 Hometask_2_3 Hometask_3_3 Hometask_4_4 Hometask_6_1
+       Hometask_8_1 Hometask_11_2 Hometask_12 Hometask_14_1 Hometask_16_1
+       Hometask_18_2 Lesson_1 Lesson_4"
+
+generator="$build_dir/Tools/input_generator"
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+
+TIMEFORMAT=%R
+status=0
+for task in $tasks; do
+    binary="$build_dir/$task/$task"
+    input="$input_dir/$task.$scale.in"
+    if [ ! -x "$binary" ]; then
+        echo "$task: $binary not found" >&2
+        continue
+    fi
+    if [ ! -f "$input" ]; then
+        "$generator" "$task" "$scale" > "$input.tmp"
+        mv "$input.tmp" "$input"
+    fi
+
+    # Задача 12 читает bridges.in и пишет bridges.out в текущей директории
+    ln -sf "$input" "$work_dir/bridges.in"
+
+    best=""
+    for ((i = 0; i < repeats; i++)); do
+        if ! seconds=$( { time (cd "$work_dir" &&
+                                "$binary" < "$input" > /dev/null 2>&1); } \
+                        2>&1 ); then
+            echo "$task: failed" >&2
+            best="-"
+            status=1
+            break
+        fi
+        if [ -z "$best" ] || awk "BEGIN { exit !($seconds < $best) }"; then
+            best=$seconds
+        fi
+    done
+    printf "%-16s %s\n" "$task" "$best"
+done
+
+exit $status
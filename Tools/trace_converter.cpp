@@ -0,0 +1,46 @@
+// Преобразование текстовых команд очереди (дека) в двоичную трассу.
+//
+// Использование: trace_converter < <текстовые команды> > <трасса>
+// Читает из stdin входные данные задачи 1_3 или Lesson_1 (n и n пар
+// "команда значение") и печатает в stdout двоичную трассу тех же команд
+// (command_trace.h). Задачи 1_3 и Lesson_1 выполняют трассу, поданную на
+// stdin из файла, без разбора текста.
+
+
+#include <iostream>
+#include <vector>
+
+#include "command_trace.h"
+#include "fast_input.h"
+#include "fast_output.h"
+
+
+using std::cerr;
+using std::vector;
+
+
+int main() {
+    FastInput input;
+    int n = 0;
+    if (!input.ReadInt(n) || (n < 0)) {
+        cerr << "Invalid number of commands\n";
+        return 1;
+    }
+
+    vector<QueueCommand> commands(n);
+    for (QueueCommand &command : commands) {
+        if (!input.ReadInt(command.command) || !input.ReadInt(command.value)) {
+            cerr << "Expected " << n << " commands\n";
+            return 1;
+        }
+    }
+
+    FastOutput output;
+    CommandTrace::Write(commands, output);
+    if (!output.Flush()) {
+        cerr << "Cannot write trace\n";
+        return 1;
+    }
+
+    return 0;
+}